@@ -153,6 +153,16 @@ class AudioBuffer
         return Channels;
     }
 
+    SampleType* data()
+    {
+        return m_data.data();
+    }
+
+    const SampleType* data() const
+    {
+        return m_data.data();
+    }
+
     SampleType& operator()(size_t frame, size_t channel)
     {
         return m_data[frame * Channels + channel];
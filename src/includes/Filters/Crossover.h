@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+
+#include "Audio/AudioBuffer.h"
+#include "Filters/Biquad.h"
+
+namespace AbacDsp
+{
+/*
+ * Linkwitz-Riley (LR4) crossover splitting each channel into Bands bands in one pass over the input.
+ *
+ * The usual tree splits the signal at the lowest frequency, passes the high part on to the next split and runs the
+ * lower bands through the allpass of every later split, so all bands sum to the same allpass (flat magnitude).
+ * Written per band, band b is the cascade over all crossover stages k of
+ *   HP_k (k < b),  LP_k (k == b),  AP_k (k > b)
+ * with LP/HP the LR4 pair (two Butterworth biquads) and AP the second order allpass at the same frequency that
+ * LP_k + HP_k add up to. Every band now has the same structure of 2 * (Bands - 1) biquads fed by the input, so the
+ * bands (and channels) run side by side in the lanes of one biquad section per position (like BiquadBank).
+ * The sections of a cascade depend on each other sample by sample, a single recursion is bound by the latency of its
+ * multiply-adds. So the sections run as a wavefront over a chunk of frames: in step t section s works on frame t - s,
+ * all sections of a step are independent and their latencies overlap.
+ *
+ * Lane of channel c and band b: c * Bands + b, padded to full SSE registers with zero lanes (all coefficients 0, they
+ * output silence and nothing reads them).
+ */
+template <size_t Bands, size_t Channels = 1>
+class Crossover
+{
+public:
+    static_assert(Bands >= 2, "a crossover needs at least two bands");
+    static_assert(Channels >= 1, "a crossover needs at least one channel");
+    static constexpr size_t STAGES = Bands - 1;
+    static constexpr size_t SECTIONS = 2 * STAGES;
+    static constexpr size_t LANES = (Bands * Channels + 3) / 4 * 4;
+
+    explicit Crossover(const float sampleRate)
+        : m_sampleRate(sampleRate)
+    {
+        std::array<float, STAGES> frequencies;
+        for (size_t k = 0; k < STAGES; ++k)
+        {
+            // default: spread logarithmically between 100 Hz and 10 kHz
+            frequencies[k] = 100.f * std::pow(100.f, STAGES > 1 ? static_cast<float>(k) / (STAGES - 1) : 0.5f);
+        }
+        setFrequencies(frequencies);
+    }
+
+    void setSampleRate(const float sampleRate)
+    {
+        m_sampleRate = sampleRate;
+        setFrequencies(m_frequencies);
+    }
+
+    // crossover frequencies, ascending
+    void setFrequencies(const std::array<float, STAGES>& frequencies)
+    {
+        m_frequencies = frequencies;
+        constexpr auto butterworthQ = std::numbers::sqrt2_v<float> / 2;
+        for (size_t k = 0; k < STAGES; ++k)
+        {
+            const auto f = m_frequencies[k];
+            const auto lowPass = designBiquad(BiquadFilterType::LowPass, m_sampleRate, f, butterworthQ, 0.f);
+            const auto highPass = designBiquad(BiquadFilterType::HighPass, m_sampleRate, f, butterworthQ, 0.f);
+            // the allpass from the poles of the low pass, so LP + HP and AP match down to rounding also at low
+            // frequencies, where the sin/cos based allpass design loses precision in float
+            const auto [lb0, lb1, lb2, a1, a2] = lowPass;
+            const std::array allPass{a2, a1, 1.f, a1, a2};
+            constexpr std::array<float, 5> passThrough{1.f, 0.f, 0.f, 0.f, 0.f};
+            for (size_t c = 0; c < Channels; ++c)
+            {
+                for (size_t b = 0; b < Bands; ++b)
+                {
+                    const auto& first = k < b ? highPass : k == b ? lowPass : allPass;
+                    const auto& second = k < b ? highPass : k == b ? lowPass : passThrough;
+                    setSection(m_sections[2 * k], c * Bands + b, first);
+                    setSection(m_sections[2 * k + 1], c * Bands + b, second);
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] const std::array<float, STAGES>& getFrequencies() const
+    {
+        return m_frequencies;
+    }
+
+    // interleaved frames in[frame * Channels + c] to one interleaved buffer per band, out[b][frame * Channels + c]
+    void processFrames(const float* in, const std::array<float*, Bands>& out, const size_t numFrames)
+    {
+        std::array<Lane, ChunkSize> frames{};
+        for (size_t offset = 0; offset < numFrames; offset += ChunkSize)
+        {
+            const auto count = std::min(ChunkSize, numFrames - offset);
+            for (size_t i = 0; i < count; ++i)
+            {
+                for (size_t c = 0; c < Channels; ++c)
+                {
+                    std::fill_n(frames[i].data() + c * Bands, Bands, in[(offset + i) * Channels + c]);
+                }
+            }
+            for (size_t t = 0; t < count + SECTIONS - 1; ++t)
+            {
+                for (size_t s = 0; s < SECTIONS; ++s)
+                {
+                    const auto i = t - s; // wraps around before the wavefront reaches section s
+                    if (i < count)
+                    {
+                        step(m_sections[s], frames[i]);
+                    }
+                }
+            }
+            for (size_t b = 0; b < Bands; ++b)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    for (size_t c = 0; c < Channels; ++c)
+                    {
+                        out[b][(offset + i) * Channels + c] = frames[i][c * Bands + b];
+                    }
+                }
+            }
+        }
+    }
+
+    // mono: one output buffer per band
+    void processBlock(const float* in, const std::array<float*, Bands>& out, const size_t numSamples)
+    {
+        static_assert(Channels == 1, "use processFrames() or the AudioBuffer overload for more channels");
+        processFrames(in, out, numSamples);
+    }
+
+    // every channel of the buffer, one buffer of the same layout per band
+    template <size_t NumFrames>
+    void processBlock(const AudioBuffer<Channels, NumFrames>& in,
+                      std::array<AudioBuffer<Channels, NumFrames>, Bands>& out)
+    {
+        std::array<float*, Bands> targets;
+        for (size_t b = 0; b < Bands; ++b)
+        {
+            targets[b] = out[b].data();
+        }
+        processFrames(in.data(), targets, NumFrames);
+    }
+
+    void reset()
+    {
+        for (auto& section : m_sections)
+        {
+            section.z0 = {};
+            section.z1 = {};
+        }
+    }
+
+private:
+    static constexpr size_t ChunkSize{64};
+
+    struct alignas(16) Lane : std::array<float, LANES>
+    {
+    };
+
+    struct Section
+    {
+        Lane b0, b1, b2, a1, a2;
+        Lane z0{}, z1{};
+    };
+
+    static void setSection(Section& section, const size_t lane, const std::array<float, 5>& cf)
+    {
+        section.b0[lane] = cf[0];
+        section.b1[lane] = cf[1];
+        section.b2[lane] = cf[2];
+        section.a1[lane] = cf[3];
+        section.a2[lane] = cf[4];
+    }
+
+    // transposed direct form II over all lanes, in place
+    static void step(Section& section, Lane& x)
+    {
+        for (size_t l = 0; l < LANES; ++l)
+        {
+            const auto y = x[l] * section.b0[l] + section.z0[l];
+            section.z0[l] = x[l] * section.b1[l] + section.z1[l] - section.a1[l] * y;
+            section.z1[l] = x[l] * section.b2[l] - section.a2[l] * y;
+            x[l] = y;
+        }
+    }
+
+    float m_sampleRate;
+    std::array<float, STAGES> m_frequencies{};
+    std::array<Section, SECTIONS> m_sections{}; // 2 * k and 2 * k + 1 belong to stage k
+};
+}
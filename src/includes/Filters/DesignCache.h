@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace AbacDsp
+{
+// Fixed size memo of filter designs, keyed on the design parameters (compared exactly, Key needs operator==).
+// No allocation, the least recently used entry is replaced when full. Not synchronized: one cache per owner/thread.
+template <typename Key, typename Value, size_t Capacity>
+class DesignCache
+{
+public:
+    static_assert(Capacity > 0, "DesignCache needs at least one entry");
+
+    // stored value, nullptr on a miss
+    [[nodiscard]] const Value* find(const Key& key)
+    {
+        for (size_t i = 0; i < m_size; ++i)
+        {
+            if (m_keys[i] == key)
+            {
+                ++m_hits;
+                m_lastUse[i] = ++m_clock;
+                return &m_values[i];
+            }
+        }
+        ++m_misses;
+        return nullptr;
+    }
+
+    const Value& insert(const Key& key, const Value& value)
+    {
+        size_t slot = m_size;
+        if (m_size < Capacity)
+        {
+            ++m_size;
+        }
+        else
+        {
+            slot = 0;
+            for (size_t i = 1; i < Capacity; ++i)
+            {
+                if (m_lastUse[i] < m_lastUse[slot])
+                {
+                    slot = i;
+                }
+            }
+        }
+        m_keys[slot] = key;
+        m_values[slot] = value;
+        m_lastUse[slot] = ++m_clock;
+        return m_values[slot];
+    }
+
+    // stored value or design() stored under key
+    template <typename Design>
+    const Value& get(const Key& key, Design&& design)
+    {
+        if (const auto* value = find(key))
+        {
+            return *value;
+        }
+        return insert(key, design());
+    }
+
+    void clear()
+    {
+        m_size = 0;
+    }
+
+    void resetCounters()
+    {
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] size_t hits() const
+    {
+        return m_hits;
+    }
+
+    [[nodiscard]] size_t misses() const
+    {
+        return m_misses;
+    }
+
+private:
+    std::array<Key, Capacity> m_keys{};
+    std::array<Value, Capacity> m_values{};
+    std::array<uint64_t, Capacity> m_lastUse{};
+    uint64_t m_clock{0};
+    size_t m_size{0};
+    size_t m_hits{0};
+    size_t m_misses{0};
+};
+}
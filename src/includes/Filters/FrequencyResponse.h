@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+#include "Numbers/FastMath.h"
+
+namespace AbacDsp
+{
+/*
+ * Frequencies at which filter responses are evaluated, together with the trig tables of e^-jkw for the filter
+ * orders up to MAX_ORDER. Computed once in double precision, a grid is shared by all responses drawn on it.
+ * The real part is tabled as 1 - cos(kw): at low frequencies cos(kw) rounds to 1 in float and the sum of the
+ * coefficients (the response at DC) would be lost in the cancellation.
+ */
+class FrequencyGrid
+{
+public:
+    static constexpr size_t MAX_ORDER = 4;
+
+    FrequencyGrid(const float sampleRate, std::vector<float> frequencies)
+        : m_sampleRate(sampleRate)
+        , m_frequencies(std::move(frequencies))
+    {
+        for (size_t k = 0; k < MAX_ORDER; ++k)
+        {
+            m_versine[k].resize(m_frequencies.size());
+            m_sine[k].resize(m_frequencies.size());
+        }
+        for (size_t i = 0; i < m_frequencies.size(); ++i)
+        {
+            const auto w = 2 * std::numbers::pi * m_frequencies[i] / sampleRate;
+            for (size_t k = 0; k < MAX_ORDER; ++k)
+            {
+                const auto halfAngle = std::sin(static_cast<double>(k + 1) * w / 2);
+                m_versine[k][i] = static_cast<float>(2 * halfAngle * halfAngle);
+                m_sine[k][i] = static_cast<float>(std::sin(static_cast<double>(k + 1) * w));
+            }
+        }
+    }
+
+    // points spaced evenly on a log scale from lowest to highest (inclusive), as on an EQ display
+    static FrequencyGrid logarithmic(const float sampleRate, const float lowest, const float highest,
+                                     const size_t points)
+    {
+        std::vector<float> frequencies(points);
+        const auto ratio = points > 1 ? std::log(static_cast<double>(highest) / lowest) / (points - 1) : 0.;
+        for (size_t i = 0; i < points; ++i)
+        {
+            frequencies[i] = static_cast<float>(lowest * std::exp(ratio * static_cast<double>(i)));
+        }
+        return {sampleRate, std::move(frequencies)};
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_frequencies.size();
+    }
+
+    [[nodiscard]] float sampleRate() const
+    {
+        return m_sampleRate;
+    }
+
+    [[nodiscard]] const std::vector<float>& frequencies() const
+    {
+        return m_frequencies;
+    }
+
+    // 1 - cos(k w), k in [1, MAX_ORDER]
+    [[nodiscard]] const float* versine(const size_t k) const
+    {
+        return m_versine[k - 1].data();
+    }
+
+    // sin(k w), k in [1, MAX_ORDER]
+    [[nodiscard]] const float* sine(const size_t k) const
+    {
+        return m_sine[k - 1].data();
+    }
+
+private:
+    float m_sampleRate;
+    std::vector<float> m_frequencies;
+    std::array<std::vector<float>, MAX_ORDER> m_versine;
+    std::array<std::vector<float>, MAX_ORDER> m_sine;
+};
+
+
+/*
+ * Complex response H(e^jw) over a FrequencyGrid, kept as separate real and imaginary arrays so the per point loops
+ * vectorize. Starts at unity, each filter of a cascade multiplies its transfer function in (see the
+ * accumulateResponse() members of the filter classes), then magnitudes and phases are read out for all points.
+ * The grid must outlive the response.
+ */
+class FrequencyResponse
+{
+public:
+    explicit FrequencyResponse(const FrequencyGrid& grid)
+        : m_grid(&grid)
+        , m_real(grid.size(), 1.f)
+        , m_imag(grid.size(), 0.f)
+    {
+    }
+
+    void reset()
+    {
+        std::fill(m_real.begin(), m_real.end(), 1.f);
+        std::fill(m_imag.begin(), m_imag.end(), 0.f);
+    }
+
+    [[nodiscard]] const FrequencyGrid& grid() const
+    {
+        return *m_grid;
+    }
+
+    // multiplies by (sum b[k] z^-k) / (sum a[k] z^-k), a[0] is usually 1
+    template <size_t N>
+    void multiply(const std::array<float, N>& b, const std::array<float, N>& a)
+    {
+        static_assert(N >= 2 && N <= FrequencyGrid::MAX_ORDER + 1, "order not covered by FrequencyGrid");
+        std::array<const float*, N - 1> versine;
+        std::array<const float*, N - 1> sine;
+        for (size_t k = 1; k < N; ++k)
+        {
+            versine[k - 1] = m_grid->versine(k);
+            sine[k - 1] = m_grid->sine(k);
+        }
+        float sumB = 0;
+        float sumA = 0;
+        for (size_t k = 0; k < N; ++k)
+        {
+            sumB += b[k];
+            sumA += a[k];
+        }
+        auto* re = m_real.data();
+        auto* im = m_imag.data();
+        for (size_t i = 0; i < m_real.size(); ++i)
+        {
+            // e^-jkw = cos(kw) - j sin(kw) = 1 - versine - j sine
+            auto nRe = sumB;
+            auto nIm = 0.f;
+            auto dRe = sumA;
+            auto dIm = 0.f;
+            for (size_t k = 1; k < N; ++k)
+            {
+                nRe -= b[k] * versine[k - 1][i];
+                nIm -= b[k] * sine[k - 1][i];
+                dRe -= a[k] * versine[k - 1][i];
+                dIm -= a[k] * sine[k - 1][i];
+            }
+            // (re + j im) * n * conj(d) / |d|^2
+            const auto scale = 1.f / (dRe * dRe + dIm * dIm);
+            const auto hRe = (nRe * dRe + nIm * dIm) * scale;
+            const auto hIm = (nIm * dRe - nRe * dIm) * scale;
+            const auto r = re[i];
+            re[i] = r * hRe - im[i] * hIm;
+            im[i] = r * hIm + im[i] * hRe;
+        }
+    }
+
+    // multiplies by transfer(i, re, im), which sets the response at grid point i, e.g. of a filter that isn't a
+    // rational function of low order in z^-1
+    template <typename Transfer>
+    void multiplyEach(Transfer&& transfer)
+    {
+        auto* re = m_real.data();
+        auto* im = m_imag.data();
+        for (size_t i = 0; i < m_real.size(); ++i)
+        {
+            float hRe;
+            float hIm;
+            transfer(i, hRe, hIm);
+            const auto r = re[i];
+            re[i] = r * hRe - im[i] * hIm;
+            im[i] = r * hIm + im[i] * hRe;
+        }
+    }
+
+    void multiplyBiquad(const float b0, const float b1, const float b2, const float a1, const float a2)
+    {
+        multiply<3>({b0, b1, b2}, {1.f, a1, a2});
+    }
+
+    void multiply(const FrequencyResponse& other)
+    {
+        auto* re = m_real.data();
+        auto* im = m_imag.data();
+        const auto* otherRe = other.m_real.data();
+        const auto* otherIm = other.m_imag.data();
+        for (size_t i = 0; i < m_real.size(); ++i)
+        {
+            const auto r = re[i];
+            re[i] = r * otherRe[i] - im[i] * otherIm[i];
+            im[i] = r * otherIm[i] + im[i] * otherRe[i];
+        }
+    }
+
+    void magnitude(float* out) const
+    {
+        for (size_t i = 0; i < m_real.size(); ++i)
+        {
+            out[i] = std::sqrt(m_real[i] * m_real[i] + m_imag[i] * m_imag[i]);
+        }
+    }
+
+    void magnitudeInDb(float* out) const
+    {
+        for (size_t i = 0; i < m_real.size(); ++i)
+        {
+            out[i] = FastMath::powerToDb(m_real[i] * m_real[i] + m_imag[i] * m_imag[i]);
+        }
+    }
+
+    // radians in [-pi, pi]
+    void phase(float* out) const
+    {
+        for (size_t i = 0; i < m_real.size(); ++i)
+        {
+            out[i] = FastMath::atan2(m_imag[i], m_real[i]);
+        }
+    }
+
+    [[nodiscard]] const std::vector<float>& real() const
+    {
+        return m_real;
+    }
+
+    [[nodiscard]] const std::vector<float>& imag() const
+    {
+        return m_imag;
+    }
+
+private:
+    const FrequencyGrid* m_grid;
+    std::vector<float> m_real;
+    std::vector<float> m_imag;
+};
+}
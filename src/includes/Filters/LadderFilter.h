@@ -2,11 +2,20 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <complex>
 #include <functional>
 #include <iostream>
 #include <numbers>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "Filters/FrequencyResponse.h"
+#include "Filters/Saturators.h"
+#include "Numbers/Denormals.h"
+#include "Numbers/FastMath.h"
 
 namespace AbacDsp
 {
@@ -16,7 +25,8 @@ struct PoleMixingList
     std::array<float, 5> cf;
 };
 
-static std::vector<PoleMixingList> poleMixingList = {
+// constexpr, so every mode can be compiled into its own mixing kernel (see mixPoles())
+inline constexpr auto poleMixingList = std::to_array<PoleMixingList>({
     {"LP1", {0, -1, 0, 0, 0}},
     {"LP2", {0, 0, 1, 0, 0}},
     {"LP3", {0, 0, 0, -1, 0}},
@@ -68,9 +78,10 @@ static std::vector<PoleMixingList> poleMixingList = {
     {"Double Notch (approx. 3rd Harmonic)", {1, -4, 15, -22, 11}},
 
     {"20db LP shelf", {0.1, -0.6, 1.1, -2.8, 3.2}},
-};
+});
 
-size_t findFilterIndex(std::string_view target)
+// a linear search, resolve names at compile time (constexpr auto mode = findFilterIndex("LP4")) or off the audio thread
+constexpr size_t findFilterIndex(std::string_view target)
 {
     auto it = std::ranges::find_if(
         poleMixingList,
@@ -83,6 +94,39 @@ size_t findFilterIndex(std::string_view target)
     throw std::out_of_range("PoleMixingList name not found");
 }
 
+/*
+ * sum(cf[k] * taps[k]) with the weights of poleMixingList[Mode] compiled in: zero taps vanish, unit taps become
+ * adds and subtracts. The remaining terms are summed in the same order as the runtime mix, results are identical.
+ */
+template <size_t Mode>
+[[nodiscard]] inline float mixPoles(const std::array<float, 5>& taps)
+{
+    static_assert(Mode < poleMixingList.size());
+    constexpr auto cf = poleMixingList[Mode].cf;
+    auto sum = 0.f;
+    [&]<size_t... K>(std::index_sequence<K...>)
+    {
+        auto add = [&]<size_t Tap>()
+        {
+            constexpr auto weight = cf[Tap];
+            if constexpr (weight == 1.f)
+            {
+                sum += taps[Tap];
+            }
+            else if constexpr (weight == -1.f)
+            {
+                sum -= taps[Tap];
+            }
+            else if constexpr (weight != 0.f)
+            {
+                sum += weight * taps[Tap];
+            }
+        };
+        (add.template operator()<K>(), ...);
+    }(std::make_index_sequence<5>{});
+    return sum;
+}
+
 class ResonanceFrequencyModifier
 {
 public:
@@ -223,6 +267,52 @@ public:
         return std::abs(num / denom);
     }
 
+    // multiplies the response of magnitudeBP() for all grid points into a cascade, the grid sample rate applies.
+    // Evaluated stage wise: expanded to polynomials in z^-1 the response at DC is lost in float cancellation.
+    void accumulateResponse(FrequencyResponse& response, const T cutoff, const T resonance) const
+    {
+        const T wc = T(2) * std::numbers::pi_v<T> * cutoff / static_cast<T>(response.grid().sampleRate());
+        const auto pole = static_cast<float>(std::exp(-wc));
+        const auto g = static_cast<float>(-std::expm1(-wc)); // 1 - pole without cancellation
+        const auto r = static_cast<float>(resonance);
+        std::array<float, 5> c;
+        std::transform(m_coefficients.begin(), m_coefficients.end(), c.begin(), [](const T v)
+        {
+            return static_cast<float>(v);
+        });
+        const auto* versine = response.grid().versine(1);
+        const auto* sine = response.grid().sine(1);
+        response.multiplyEach([&](const size_t i, float& hRe, float& hIm)
+        {
+            // stage g / (1 - p e^-jw), the denominator is g + p (1 - cos w) + j p sin w
+            const auto dRe = g + pole * versine[i];
+            const auto dIm = pole * sine[i];
+            const auto scale = g / (dRe * dRe + dIm * dIm);
+            const auto sRe = dRe * scale;
+            const auto sIm = -dIm * scale;
+            // y[n] = s^n
+            std::array<float, 5> yRe{1.f};
+            std::array<float, 5> yIm{0.f};
+            for (size_t n = 1; n < 5; ++n)
+            {
+                yRe[n] = yRe[n - 1] * sRe - yIm[n - 1] * sIm;
+                yIm[n] = yRe[n - 1] * sIm + yIm[n - 1] * sRe;
+            }
+            float nRe = 0;
+            float nIm = 0;
+            for (size_t n = 0; n < 5; ++n)
+            {
+                nRe += c[n] * yRe[n];
+                nIm += c[n] * yIm[n];
+            }
+            const auto denRe = 1.f + r * (-yRe[4] + 2.f * yRe[3] - yRe[2]);
+            const auto denIm = r * (-yIm[4] + 2.f * yIm[3] - yIm[2]);
+            const auto denScale = 1.f / (denRe * denRe + denIm * denIm);
+            hRe = (nRe * denRe + nIm * denIm) * denScale;
+            hIm = (nIm * denRe - nRe * denIm) * denScale;
+        });
+    }
+
     T magnitudeBP2(T pole, T w, T resonance) const
     {
         // w in radians (0...pi) at 48kHz
@@ -286,21 +376,38 @@ private:
  * http://electronotes.netfirms.com/EN85VCF.pdf
  * https://expeditionelectronics.com/Diy/Polemixing/math
  *
+ * DenormalPolicy::Flush zeroes the stages and the smoothed resonance once they decay below -300 dB.
+ * Saturation picks the feedback nonlinearity (cost/character) at compile time, see Saturators.h.
+ * AdaaOrder 1 or 2 runs it antiderivative anti-aliased (AdaaSaturator): at high drive and resonance the aliasing drops
+ * to about that of 2x to 4x oversampling at base rate. The ADAA adds half a sample (1) or a sample (2) of delay to the
+ * feedback loop, the resonance peak moves down slightly.
  */
 
-class Filter1Pole4StageSmooth
+template <DenormalPolicy Denormals = DenormalPolicy::None, Saturator Saturation = SqrtSaturator, size_t AdaaOrder = 0>
+    requires AntiderivativeSaturator<Saturation, AdaaOrder>
+class BasicFilter1Pole4StageSmooth
 {
 public:
-    explicit Filter1Pole4StageSmooth(float sampleRate)
+    explicit BasicFilter1Pole4StageSmooth(float sampleRate)
         : m_sampleRate(sampleRate)
     {
         setCutoffFrequency(m_cutoffFrequency);
         m_pole = m_targetPole;
     }
 
+    // free weights, processBlock() mixes them at runtime
     void setFilterCoefficients(const std::array<float, 5>& cf)
     {
         m_coefficients = cf;
+        m_kernel = &BasicFilter1Pole4StageSmooth::processMode<FreeMixing>;
+    }
+
+    // index into poleMixingList, processBlock() runs the kernel compiled for the mode: a table lookup, no search and no
+    // allocation, safe on the audio thread
+    void setPoleMixing(const size_t index)
+    {
+        m_coefficients = poleMixingList[index].cf;
+        m_kernel = modeKernel(index);
     }
 
     void setParameterSmoothTimeMs(float ms)
@@ -314,15 +421,23 @@ public:
         m_targetResonance = value;
     }
 
+    // piecewise cubic, the coefficients are selected instead of the polynomials: branch free for modulation loops
+    // (the compiler turns a select of two results back into branches)
     static float adaptResonanceFrequency(const float x)
     {
-        if (x > 2800.f)
-        {
-            return std::clamp(-11224.374f + 6.806917f * x - 7.332340e-4f * x * x + 3.496297e-8f * x * x * x, 10.f,
-                              22000.f);
-        }
-        return std::clamp(-0.03223791634f + 1.005588288f * x - 3.971210551e-06f * x * x + 3.645793593e-09f * x * x * x,
-                          10.f, 22000.f);
+        const auto isHigh = x > 2800.f;
+        const auto c0 = isHigh ? -11224.374f : -0.03223791634f;
+        const auto c1 = isHigh ? 6.806917f : 1.005588288f;
+        const auto c2 = isHigh ? -7.332340e-4f : -3.971210551e-06f;
+        const auto c3 = isHigh ? 3.496297e-8f : 3.645793593e-09f;
+        return FastMath::clampPositive(c0 + c1 * x + c2 * x * x + c3 * x * x * x, 10.f, 22000.f);
+    }
+
+    // the pole of setCutoffFrequency() through FastMath::exp2 (relative error < 1E-6), vectorizes
+    static float cutoffToPoleFast(const float sampleRate, const float cutoffFrequency)
+    {
+        constexpr auto scale = -2.f * std::numbers::pi_v<float> * std::numbers::log2e_v<float>;
+        return FastMath::exp2(scale * adaptResonanceFrequency(cutoffFrequency) / sampleRate);
     }
 
     void setCutoffFrequency(float cutoffFrequency)
@@ -338,58 +453,130 @@ public:
         m_targetPole = std::exp(-std::numbers::pi * 2.0f * cutoffFrequency / m_sampleRate);
     }
 
+    // the feedback saturation, see Saturators.h for the curves
     static float compress(const float in)
     {
-        /*
-        +--------------------+------------------------------+---------------------+-----------+
-        | Function           | Formula                      | Shape               | CPU       |
-        +--------------------+------------------------------+---------------------+-----------+
-        | x/sqrt             | x / sqrt(1 + x^2)            | Soft, arcsine-like  | medium    |
-        | tanh               | tanh(x)                      | Soft, classic       | slow      |
-        | arctangent         | (2/pi) * atan(x)             | Soft, slowest knee  | slow      |
-        | cubic soft-clip    | x - (1/3)x^3  (clamp -1..1)  | Soft, analog-like   | very fast |
-        | reciprocal sigmoid | x / (1 + abs(x))             | Soft (different)    | fast      |
-        | hard clip          | clamp(x, -1, 1)              | Hard                | fastest   |
-        +--------------------+------------------------------+---------------------+-----------+
-        */
-        return in / std::sqrt(1 + in * in);
+        return Saturation::process(in);
     }
 
     [[nodiscard]] float step(float in)
+    {
+        return stepMode<FreeMixing>(in);
+    }
+
+    void processBlock(const float* source, float* target, size_t numSamples)
+    {
+        (this->*m_kernel)(source, target, numSamples);
+    }
+
+    /*
+     * Audio rate modulation (filter FM, envelopes): a cutoff in Hz per sample, as if setCutoffFrequency() was called
+     * before each step, the parameter smoothing still applies. The poles come from cutoffToPoleFast() in chunks,
+     * source and target may be the same buffer.
+     */
+    void processBlock(const float* source, const float* cutoff, float* target, const size_t numSamples)
+    {
+        processModulated(source, cutoff, nullptr, target, numSamples);
+    }
+
+    // as above with a resonance per sample as well
+    void processBlock(const float* source, const float* cutoff, const float* resonance, float* target,
+                      const size_t numSamples)
+    {
+        processModulated(source, cutoff, resonance, target, numSamples);
+    }
+
+    void reset()
+    {
+        std::ranges::fill(m_v, 0.f);
+        m_pole = m_targetPole;
+        m_reso = m_targetResonance;
+        m_saturator.reset();
+    }
+
+private:
+    static constexpr size_t ModulationChunk{64};
+    // mode index of the runtime weights in m_coefficients
+    static constexpr size_t FreeMixing{poleMixingList.size()};
+    static_assert(poleMixingList[0].cf == std::array<float, 5>{0, -1, 0, 0, 0}, "m_kernel starts with mode 0");
+
+    using BlockKernel = void (BasicFilter1Pole4StageSmooth::*)(const float*, float*, size_t);
+
+    template <size_t Mode>
+    [[nodiscard]] float stepMode(const float in)
     {
         m_pole += m_smoothingAlpha * (m_targetPole - m_pole);
         m_reso += m_smoothingAlpha * (m_targetResonance - m_reso);
 
         const auto bandpass = -m_v[3] + 2 * m_v[2] - m_v[1];
-        const auto feedback = compress(in - bandpass * m_reso);
+        const auto feedback = m_saturator.process(in - bandpass * m_reso);
 
         m_v[0] = feedback + m_pole * (m_v[0] - feedback);
         m_v[1] = m_v[0] + m_pole * (m_v[1] - m_v[0]);
         m_v[2] = m_v[1] + m_pole * (m_v[2] - m_v[1]);
         m_v[3] = m_v[2] + m_pole * (m_v[3] - m_v[2]);
+        flushDenormals<Denormals>(m_v[0], m_v[1], m_v[2], m_v[3], m_reso);
 
-        const float tmpSum = m_coefficients[0] * feedback
-                             + m_coefficients[1] * m_v[0]
-                             + m_coefficients[2] * m_v[1]
-                             + m_coefficients[3] * m_v[2]
-                             + m_coefficients[4] * m_v[3];
-        return tmpSum;
+        if constexpr (Mode == FreeMixing)
+        {
+            const float tmpSum = m_coefficients[0] * feedback
+                                 + m_coefficients[1] * m_v[0]
+                                 + m_coefficients[2] * m_v[1]
+                                 + m_coefficients[3] * m_v[2]
+                                 + m_coefficients[4] * m_v[3];
+            return tmpSum;
+        }
+        else
+        {
+            return mixPoles<Mode>({feedback, m_v[0], m_v[1], m_v[2], m_v[3]});
+        }
     }
 
-    void processBlock(const float* source, float* target, size_t numSamples)
+    template <size_t Mode>
+    void processMode(const float* source, float* target, const size_t numSamples)
     {
         for (size_t i = 0; i < numSamples; ++i)
-            target[i] = step(source[i]);
+        {
+            target[i] = stepMode<Mode>(source[i]);
+        }
     }
 
-    void reset()
+    static BlockKernel modeKernel(const size_t index)
     {
-        std::ranges::fill(m_v, 0.f);
-        m_pole = m_targetPole;
-        m_reso = m_targetResonance;
+        static constexpr auto kernels = []<size_t... Mode>(std::index_sequence<Mode...>)
+        {
+            return std::array<BlockKernel, sizeof...(Mode)>{&BasicFilter1Pole4StageSmooth::processMode<Mode>...};
+        }(std::make_index_sequence<poleMixingList.size()>{});
+        return kernels[index];
+    }
+
+    void processModulated(const float* source, const float* cutoff, const float* resonance, float* target,
+                          const size_t numSamples)
+    {
+        std::array<float, ModulationChunk> poles;
+        for (size_t offset = 0; offset < numSamples; offset += ModulationChunk)
+        {
+            const auto count = std::min(ModulationChunk, numSamples - offset);
+            for (size_t i = 0; i < count; ++i)
+            {
+                poles[i] = cutoffToPoleFast(m_sampleRate, cutoff[offset + i]);
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_targetPole = poles[i];
+                if (resonance)
+                {
+                    m_targetResonance = resonance[offset + i];
+                }
+                target[offset + i] = step(source[offset + i]);
+            }
+        }
+        if (numSamples > 0)
+        {
+            m_cutoff = cutoff[numSamples - 1];
+        }
     }
 
-private:
     float m_sampleRate{48000.f};
     float m_cutoffFrequency{1000.f};
 
@@ -404,6 +591,256 @@ private:
 
     std::array<float, 4> m_v{0, 0, 0, 0};
     std::array<float, 5> m_coefficients{0, -1, 0, 0, 0};
+    BlockKernel m_kernel{&BasicFilter1Pole4StageSmooth::processMode<0>}; // LP1, the default weights
+    [[no_unique_address]] AdaaSaturator<Saturation, AdaaOrder> m_saturator;
+};
+
+using Filter1Pole4StageSmooth = BasicFilter1Pole4StageSmooth<>;
+
+template <Saturator Saturation>
+using Filter1Pole4StageSaturated = BasicFilter1Pole4StageSmooth<DenormalPolicy::None, Saturation>;
+
+template <Saturator Saturation, size_t Order>
+using Filter1Pole4StageAntialiased = BasicFilter1Pole4StageSmooth<DenormalPolicy::None, Saturation, Order>;
+
+/*
+ * Voices independent Filter1Pole4StageSmooth (e.g. one per voice of a polysynth) with parameters, smoothing and
+ * stage state kept as structure of arrays, every step advances all voices in SIMD lanes. Each voice has its own
+ * cutoff, resonance and pole mixing, all voices share the Saturation policy. The default FastSqrtSaturator is the
+ * curve of Filter1Pole4StageSmooth in a form that vectorizes, the output matches single filters to rounding.
+ * The native layout is interleaved (frame by frame), planar voice buffers are transposed in small chunks.
+ */
+template <size_t Voices, DenormalPolicy Denormals = DenormalPolicy::None,
+          Saturator Saturation = FastSqrtSaturator>
+class Filter1Pole4StageSmoothBank
+{
+public:
+    static_assert(Voices > 0, "Filter1Pole4StageSmoothBank needs at least one voice");
+
+    explicit Filter1Pole4StageSmoothBank(const float sampleRate)
+        : m_sampleRate(sampleRate)
+    {
+        for (size_t voice = 0; voice < Voices; ++voice)
+        {
+            setCutoffFrequency(voice, 1000.f);
+            setFilterCoefficients(voice, {0, -1, 0, 0, 0});
+        }
+        m_pole = m_targetPole;
+    }
+
+    void setFilterCoefficients(const size_t voice, const std::array<float, 5>& cf)
+    {
+        for (size_t k = 0; k < 5; ++k)
+        {
+            m_coefficients[k][voice] = cf[k];
+        }
+    }
+
+    // index into poleMixingList
+    void setPoleMixing(const size_t voice, const size_t index)
+    {
+        setFilterCoefficients(voice, poleMixingList[index].cf);
+    }
+
+    // shared by all voices
+    void setParameterSmoothTimeMs(const float ms)
+    {
+        const float T = ms * 1e-3f;
+        m_smoothingAlpha = 1.f - std::exp(-1.f / (T * m_sampleRate));
+    }
+
+    void setResonance(const size_t voice, const float value)
+    {
+        m_targetResonance[voice] = value;
+    }
+
+    void setCutoffFrequency(const size_t voice, const float cutoffFrequency)
+    {
+        const float x = Filter1Pole4StageSmooth::adaptResonanceFrequency(cutoffFrequency);
+        m_targetPole[voice] = std::exp(-std::numbers::pi * 2.0f * x / m_sampleRate);
+    }
+
+    void setCutoffFrequencyClean(const size_t voice, const float cutoffFrequency)
+    {
+        m_targetPole[voice] = std::exp(-std::numbers::pi * 2.0f * cutoffFrequency / m_sampleRate);
+    }
+
+    // interleaved frames: in[frame * Voices + voice], in place is allowed
+    void processFrames(const float* in, float* out, const size_t numFrames)
+    {
+        processFramesImpl<false, false>(in, nullptr, nullptr, out, numFrames);
+    }
+
+    // with a cutoff (Hz) per frame and voice in the same layout, as if setCutoffFrequency() was called before each
+    // frame. The poles are computed in the lane loop (cutoffToPoleFast()).
+    void processFrames(const float* in, const float* cutoff, float* out, const size_t numFrames)
+    {
+        processFramesImpl<true, false>(in, cutoff, nullptr, out, numFrames);
+    }
+
+    // as above with a resonance per frame and voice as well, nullptr keeps the resonance of setResonance()
+    void processFrames(const float* in, const float* cutoff, const float* resonance, float* out,
+                       const size_t numFrames)
+    {
+        if (resonance)
+        {
+            processFramesImpl<true, true>(in, cutoff, resonance, out, numFrames);
+            return;
+        }
+        processFramesImpl<true, false>(in, cutoff, nullptr, out, numFrames);
+    }
+
+    // planar: one pointer per voice, in place is allowed
+    void processBlock(const float* const* in, float* const* out, const size_t numSamples)
+    {
+        std::array<float, ChunkSize * Voices> frames;
+        for (size_t offset = 0; offset < numSamples; offset += ChunkSize)
+        {
+            const auto count = std::min(ChunkSize, numSamples - offset);
+            interleave(in, frames, offset, count);
+            processFrames(frames.data(), frames.data(), count);
+            deinterleave(frames, out, offset, count);
+        }
+    }
+
+    // planar with a per sample cutoff buffer per voice
+    void processBlock(const float* const* in, const float* const* cutoff, float* const* out, const size_t numSamples)
+    {
+        processBlock(in, cutoff, nullptr, out, numSamples);
+    }
+
+    // planar with per sample cutoff and resonance buffers per voice, resonance nullptr as in processFrames()
+    void processBlock(const float* const* in, const float* const* cutoff, const float* const* resonance,
+                      float* const* out, const size_t numSamples)
+    {
+        std::array<float, ChunkSize * Voices> frames;
+        std::array<float, ChunkSize * Voices> cutoffFrames;
+        std::array<float, ChunkSize * Voices> resonanceFrames;
+        for (size_t offset = 0; offset < numSamples; offset += ChunkSize)
+        {
+            const auto count = std::min(ChunkSize, numSamples - offset);
+            interleave(in, frames, offset, count);
+            interleave(cutoff, cutoffFrames, offset, count);
+            if (resonance)
+            {
+                interleave(resonance, resonanceFrames, offset, count);
+            }
+            processFrames(frames.data(), cutoffFrames.data(), resonance ? resonanceFrames.data() : nullptr,
+                          frames.data(), count);
+            deinterleave(frames, out, offset, count);
+        }
+    }
+
+    void reset()
+    {
+        for (size_t voice = 0; voice < Voices; ++voice)
+        {
+            reset(voice);
+        }
+    }
+
+    // e.g. on note on of a voice
+    void reset(const size_t voice)
+    {
+        for (auto& stage : m_v)
+        {
+            stage[voice] = 0.f;
+        }
+        m_pole[voice] = m_targetPole[voice];
+        m_reso[voice] = m_targetResonance[voice];
+    }
+
+private:
+    static constexpr size_t ChunkSize{64};
+    static constexpr size_t Alignment{std::min<size_t>(std::bit_ceil(Voices * sizeof(float)), 64)};
+
+    struct alignas(Alignment) Lane : std::array<float, Voices>
+    {
+    };
+
+    static void interleave(const float* const* planar, std::array<float, ChunkSize * Voices>& frames,
+                           const size_t offset, const size_t count)
+    {
+        for (size_t voice = 0; voice < Voices; ++voice)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                frames[i * Voices + voice] = planar[voice][offset + i];
+            }
+        }
+    }
+
+    static void deinterleave(const std::array<float, ChunkSize * Voices>& frames, float* const* planar,
+                             const size_t offset, const size_t count)
+    {
+        for (size_t voice = 0; voice < Voices; ++voice)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                planar[voice][offset + i] = frames[i * Voices + voice];
+            }
+        }
+    }
+
+    template <bool Modulated, bool ModulatedResonance>
+    void processFramesImpl(const float* in, const float* cutoff, const float* resonance, float* out,
+                           const size_t numFrames)
+    {
+        // the ladder state lives in registers for the block, stores into out (may be in) would force it back to memory
+        const auto alpha = m_smoothingAlpha;
+        const auto sampleRate = m_sampleRate;
+        Lane targetPole = m_targetPole, targetResonance = m_targetResonance;
+        const Lane c0 = m_coefficients[0], c1 = m_coefficients[1], c2 = m_coefficients[2], c3 = m_coefficients[3],
+                   c4 = m_coefficients[4];
+        Lane pole = m_pole, reso = m_reso, v0 = m_v[0], v1 = m_v[1], v2 = m_v[2], v3 = m_v[3];
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            const auto* x = in + i * Voices;
+            auto* y = out + i * Voices;
+            for (size_t l = 0; l < Voices; ++l)
+            {
+                if constexpr (Modulated)
+                {
+                    targetPole[l] = Filter1Pole4StageSmooth::cutoffToPoleFast(sampleRate, cutoff[i * Voices + l]);
+                }
+                if constexpr (ModulatedResonance)
+                {
+                    targetResonance[l] = resonance[i * Voices + l];
+                }
+                pole[l] += alpha * (targetPole[l] - pole[l]);
+                reso[l] += alpha * (targetResonance[l] - reso[l]);
+
+                const auto bandpass = -v3[l] + 2 * v2[l] - v1[l];
+                const auto driven = x[l] - bandpass * reso[l];
+                const auto feedback = Saturation::process(driven);
+
+                v0[l] = feedback + pole[l] * (v0[l] - feedback);
+                v1[l] = v0[l] + pole[l] * (v1[l] - v0[l]);
+                v2[l] = v1[l] + pole[l] * (v2[l] - v1[l]);
+                v3[l] = v2[l] + pole[l] * (v3[l] - v2[l]);
+                flushDenormals<Denormals>(v0[l], v1[l], v2[l], v3[l], reso[l]);
+
+                y[l] = c0[l] * feedback + c1[l] * v0[l] + c2[l] * v1[l] + c3[l] * v2[l] + c4[l] * v3[l];
+            }
+        }
+        m_pole = pole;
+        m_reso = reso;
+        m_v = {v0, v1, v2, v3};
+        if constexpr (Modulated)
+        {
+            m_targetPole = targetPole;
+            m_targetResonance = targetResonance;
+        }
+    }
+
+    float m_sampleRate;
+    float m_smoothingAlpha{0.01f};
+    Lane m_pole{};
+    Lane m_targetPole{};
+    Lane m_reso{};
+    Lane m_targetResonance{};
+    std::array<Lane, 4> m_v{};
+    std::array<Lane, 5> m_coefficients{};
 };
 
 
@@ -2,8 +2,17 @@
 
 #include <array>
 #include <algorithm>
+#include <bit>
 #include <cmath>
+#include <limits>
+#include <numeric>
 #include <numbers>
+#include <type_traits>
+
+#include "Audio/AudioBuffer.h"
+#include "Filters/FrequencyResponse.h"
+#include "Numbers/Denormals.h"
+#include "Numbers/FastMath.h"
 
 namespace AbacDsp
 {
@@ -52,25 +61,53 @@ public:
     void setCutoff(const float cutoff) noexcept
     {
         m_cutoff = cutoff;
-        if (cutoff >= m_sampleRate / 2)
+        m_fdbk = cutoffToFeedback(m_sampleRate, cutoff);
+    }
+
+    [[nodiscard]] static float cutoffToFeedback(const float sampleRate, const float cutoff) noexcept
+    {
+        if (cutoff >= sampleRate / 2)
         {
-            m_fdbk = 0;
+            return 0;
+        }
+        const auto w0 = 2.0f * std::numbers::pi_v<float> * cutoff / sampleRate;
+        if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::AllPass)
+        {
+            const auto tanW = std::tan(w0 * 0.5f);
+            return (tanW - 1.0f) / (tanW + 1.0f);
         }
         else
         {
-            const auto w0 = 2.0f * std::numbers::pi_v<float> * cutoff / m_sampleRate;
-            if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::AllPass)
-            {
-                const auto tanW = std::tan(w0 * 0.5f);
-                m_fdbk = (tanW - 1.0f) / (tanW + 1.0f);
-            }
-            else
-            {
-                m_fdbk = std::exp(-w0);
-            }
+            return std::exp(-w0);
+        }
+    }
+
+    /*
+     * The feedback of setCutoff() from FastMath (deviation < 1E-6), branch free: a loop over a buffer of cutoffs
+     * vectorizes. Used by the processBlock() overloads with a cutoff per sample (audio rate modulation).
+     */
+    [[nodiscard]] static float cutoffToFeedbackFast(const float sampleRate, const float cutoff) noexcept
+    {
+        const auto Fc = FastMath::clampPositive(cutoff / sampleRate, 0.f, 0.5f);
+        const auto isNyquist = Fc >= 0.5f;
+        if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::AllPass)
+        {
+            const auto tanW = FastMath::tanPi(std::min(Fc, 0.4999f));
+            return isNyquist ? 0.f : (tanW - 1.0f) / (tanW + 1.0f);
+        }
+        else
+        {
+            constexpr auto scale = -2.f * std::numbers::pi_v<float> * std::numbers::log2e_v<float>;
+            return isNyquist ? 0.f : FastMath::exp2(scale * Fc);
         }
     }
 
+    void setCutoffFast(const float cutoff) noexcept
+    {
+        m_cutoff = cutoff;
+        m_fdbk = cutoffToFeedbackFast(m_sampleRate, cutoff);
+    }
+
     void setFeedback(const float value) noexcept
     {
         m_fdbk = value;
@@ -119,21 +156,141 @@ public:
         return 0.0f;
     }
 
+    // multiplies the transfer function of the current feedback into a response of a cascade
+    void accumulateResponse(FrequencyResponse& response) const
+    {
+        const auto p = m_fdbk;
+        if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::LowPass)
+        {
+            response.multiply<2>({1.f - p, 0.f}, {1.f, -p});
+        }
+        if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::HighPassLeaky)
+        {
+            // 1 - (1 - p) / (1 - p z^-1)
+            response.multiply<2>({p, -p}, {1.f, -p});
+        }
+        if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::HighPass)
+        {
+            const auto a0 = 0.5f * (1.f + p);
+            response.multiply<2>({a0, -a0}, {1.f, -p});
+        }
+        if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::AllPass)
+        {
+            response.multiply<2>({p, 1.f}, {1.f, p});
+        }
+    }
+
     void reset() noexcept
     {
         static_cast<Derived*>(this)->resetImpl();
     }
 
 protected:
+    static constexpr size_t ModulationChunk{64};
+
+    // calls stepSample(i) for every sample with the feedback of cutoff[i], converted in chunks
+    template <typename StepSample>
+    void processModulated(const float* cutoff, const size_t numSamples, StepSample&& stepSample) noexcept
+    {
+        std::array<float, ModulationChunk> feedback;
+        for (size_t offset = 0; offset < numSamples; offset += ModulationChunk)
+        {
+            const auto count = std::min(ModulationChunk, numSamples - offset);
+            for (size_t i = 0; i < count; ++i)
+            {
+                feedback[i] = cutoffToFeedbackFast(m_sampleRate, cutoff[offset + i]);
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_fdbk = feedback[i];
+                stepSample(offset + i);
+            }
+        }
+        if (numSamples > 0)
+        {
+            m_cutoff = cutoff[numSamples - 1];
+        }
+    }
+
     float m_sampleRate{48000.0f};
     float m_cutoff{100.0f};
     float m_fdbk{0.0f};
 };
 
 
+/*
+ * Block kernel for the first order recurrence s[n] = q * s[n-1] + u[n], which all one-pole characteristics reduce
+ * to. Within a block the recurrence is a parallel prefix scan (Hillis-Steele): after the steps d = 1, 2, 4, ...
+ * t[k] += q^d * t[k - d] each t[k] holds the response to the block's own inputs, s[k] = t[k] + q^(k + 1) * s[-1]
+ * adds the state carried in. log2(BlockSize) vector multiply-adds per sample instead of one dependent step, the
+ * powers of q are expanded in double. Matches the scalar recursion within 1E-5 relative to the signal level.
+ */
+template <size_t BlockSize>
+class OnePoleScan
+{
+public:
+    static_assert(BlockSize > 1 && std::has_single_bit(BlockSize), "the scan works on power of two blocks");
+    static constexpr size_t Steps = std::bit_width(BlockSize) - 1;
+
+    void compute(const float q) noexcept
+    {
+        m_q = q;
+        double power = q;
+        for (size_t j = 0; j < Steps; ++j)
+        {
+            m_stepPower[j] = static_cast<float>(power);
+            power *= power;
+        }
+        power = q;
+        for (size_t k = 0; k < BlockSize; ++k)
+        {
+            m_carryPower[k] = static_cast<float>(power);
+            power *= q;
+        }
+    }
+
+    [[nodiscard]] bool matches(const float q) const noexcept
+    {
+        return m_q == q;
+    }
+
+    // u -> s in place, state is s[-1]
+    void scan(std::array<float, BlockSize>& u, const float state) const noexcept
+    {
+        // zeros below the block, so every step runs over the full width with the shift d as a load offset
+        alignas(32) std::array<float, 2 * BlockSize> t{};
+        std::copy_n(u.data(), BlockSize, t.data() + BlockSize);
+        // unrolled, d becomes a constant
+#pragma GCC unroll 8
+        for (size_t j = 0; j < Steps; ++j)
+        {
+            const size_t d = size_t{1} << j;
+            const auto previous = t;
+            for (size_t k = BlockSize; k < 2 * BlockSize; ++k)
+            {
+                t[k] = previous[k] + m_stepPower[j] * previous[k - d];
+            }
+        }
+        for (size_t k = 0; k < BlockSize; ++k)
+        {
+            u[k] = t[BlockSize + k] + m_carryPower[k] * state;
+        }
+    }
+
+private:
+    float m_q{std::numeric_limits<float>::quiet_NaN()}; // never matches before compute()
+    std::array<float, Steps> m_stepPower{};             // q^(2^j)
+    alignas(32) std::array<float, BlockSize> m_carryPower{}; // q^(k + 1)
+};
+
+
 // --- Mono version ---
-template <OnePoleFilterCharacteristic FilterCharacteristic, bool ClampValues = false>
-class OnePoleFilter : public OnePoleBase<OnePoleFilter<FilterCharacteristic, ClampValues>, FilterCharacteristic>
+// BlockSize > 1 (8, 16) selects the scan kernel (OnePoleScan) for processBlock(), remaining samples use step().
+// With ClampValues a block whose state leaves [-1, 1] is recomputed step by step.
+template <OnePoleFilterCharacteristic FilterCharacteristic, bool ClampValues = false,
+          DenormalPolicy Denormals = DenormalPolicy::None, size_t BlockSize = 1>
+class OnePoleFilter
+    : public OnePoleBase<OnePoleFilter<FilterCharacteristic, ClampValues, Denormals, BlockSize>, FilterCharacteristic>
 {
 public:
     explicit OnePoleFilter(float sampleRate,
@@ -151,6 +308,7 @@ public:
         {
             float out = this->m_fdbk * in + m_v;
             m_v = in - this->m_fdbk * out;
+            flushDenormals<Denormals>(m_v);
             if constexpr (ClampValues)
             {
                 m_v = std::clamp(m_v, -1.f, 1.f);
@@ -160,6 +318,7 @@ public:
         if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::LowPass)
         {
             m_v = in + this->m_fdbk * (m_v - in);
+            flushDenormals<Denormals>(m_v);
             if constexpr (ClampValues)
             {
                 m_v = std::clamp(m_v, -1.f, 1.f);
@@ -172,6 +331,7 @@ public:
             const auto out = a0 * (in - m_x1) + this->m_fdbk * m_v;
             m_x1 = in;
             m_v = out;
+            flushDenormals<Denormals>(m_v);
             if constexpr (ClampValues)
             {
                 m_v = std::clamp(m_v, -1.f, 1.f);
@@ -181,6 +341,7 @@ public:
         if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::HighPassLeaky)
         {
             m_v = in + this->m_fdbk * (m_v - in);
+            flushDenormals<Denormals>(m_v);
             if constexpr (ClampValues)
             {
                 m_v = std::clamp(m_v, -1.f, 1.f);
@@ -192,14 +353,11 @@ public:
 
     void processBlock(float* inPlace, const size_t numSamples) noexcept
     {
-        if (this->m_fdbk <= 1E-8f)
+        if (std::abs(this->m_fdbk) <= 1E-8f)
         {
             return;
         }
-        std::transform(inPlace, inPlace + numSamples, inPlace, [this](const float x)
-        {
-            return this->step(x);
-        });
+        processSamples(inPlace, inPlace, numSamples);
     }
 
     void processBlock(const float* in, float* out, const size_t numSamples) noexcept
@@ -209,9 +367,15 @@ public:
             std::copy_n(in, numSamples, out);
             return;
         }
-        std::transform(in, in + numSamples, out, [this](const float x)
+        processSamples(in, out, numSamples);
+    }
+
+    // a cutoff in Hz per sample (filter FM, envelope sweeps), in and out may be the same buffer
+    void processBlock(const float* in, const float* cutoff, float* out, const size_t numSamples) noexcept
+    {
+        this->processModulated(cutoff, numSamples, [&](const size_t i)
         {
-            return this->step(x);
+            out[i] = step(in[i]);
         });
     }
 
@@ -221,15 +385,114 @@ public:
     }
 
 private:
+    void processSamples(const float* in, float* out, const size_t numSamples) noexcept
+    {
+        auto numScalar = numSamples;
+        if constexpr (BlockSize > 1)
+        {
+            numScalar = numSamples % BlockSize;
+            processScan(in, out, numSamples - numScalar);
+        }
+        const auto offset = numSamples - numScalar;
+        std::transform(in + offset, in + numSamples, out + offset, [this](const float x)
+        {
+            return this->step(x);
+        });
+    }
+
+    // numSamples is a multiple of BlockSize, in place is allowed
+    void processScan(const float* in, float* out, const size_t numSamples) noexcept
+    {
+        using enum OnePoleFilterCharacteristic;
+        const auto p = this->m_fdbk;
+        // the state recurrence s[n] = q * s[n-1] + u[n] of each characteristic
+        const auto q = FilterCharacteristic == AllPass ? -p : p;
+        if (!m_scan.matches(q))
+        {
+            m_scan.compute(q);
+        }
+        const auto a0 = (1.0f + p) * 0.5f;
+        auto v = m_v;
+        auto x1 = m_x1;
+        for (size_t i = 0; i < numSamples; i += BlockSize)
+        {
+            std::array<float, BlockSize> x;
+            std::array<float, BlockSize> s;
+            std::copy_n(in + i, BlockSize, x.data());
+            for (size_t k = 0; k < BlockSize; ++k)
+            {
+                if constexpr (FilterCharacteristic == AllPass)
+                {
+                    s[k] = (1.f - p * p) * x[k];
+                }
+                else if constexpr (FilterCharacteristic == HighPass)
+                {
+                    s[k] = a0 * (x[k] - (k == 0 ? x1 : x[k - 1]));
+                }
+                else
+                {
+                    s[k] = (1.f - p) * x[k];
+                }
+            }
+            m_scan.scan(s, v);
+            if constexpr (ClampValues)
+            {
+                // the clamp is not linear, the rare block that reaches it runs the recursion
+                if (std::ranges::any_of(s, [](const float value)
+                {
+                    return std::abs(value) > 1.f;
+                }))
+                {
+                    m_v = v;
+                    m_x1 = x1;
+                    std::transform(x.begin(), x.end(), out + i, [this](const float value)
+                    {
+                        return this->step(value);
+                    });
+                    v = m_v;
+                    x1 = m_x1;
+                    continue;
+                }
+            }
+            std::array<float, BlockSize> y;
+            for (size_t k = 0; k < BlockSize; ++k)
+            {
+                if constexpr (FilterCharacteristic == AllPass)
+                {
+                    y[k] = p * x[k] + (k == 0 ? v : s[k - 1]);
+                }
+                else if constexpr (FilterCharacteristic == HighPassLeaky)
+                {
+                    y[k] = x[k] - s[k];
+                }
+                else
+                {
+                    y[k] = s[k];
+                }
+            }
+            v = s[BlockSize - 1];
+            x1 = x[BlockSize - 1];
+            flushDenormals<Denormals>(v);
+            std::copy_n(y.data(), BlockSize, out + i);
+        }
+        m_v = v;
+        m_x1 = x1;
+    }
+
     float m_v{0.0f};
     float m_x1{0.f};
+    struct NoScan
+    {
+    };
+    [[no_unique_address]] std::conditional_t<(BlockSize > 1), OnePoleScan<BlockSize>, NoScan> m_scan;
 };
 
 
 // --- Stereo version ---
-template <OnePoleFilterCharacteristic FilterCharacteristic, bool ClampValues = false>
+template <OnePoleFilterCharacteristic FilterCharacteristic, bool ClampValues = false,
+          DenormalPolicy Denormals = DenormalPolicy::None>
 class OnePoleFilterStereo
-    : public OnePoleBase<OnePoleFilterStereo<FilterCharacteristic, ClampValues>, FilterCharacteristic>
+    : public OnePoleBase<OnePoleFilterStereo<FilterCharacteristic, ClampValues, Denormals>, FilterCharacteristic>
 {
 public:
     explicit OnePoleFilterStereo(const float sampleRate, const float cutoff = 100.0f) noexcept
@@ -247,6 +510,7 @@ public:
             const auto tmpR = this->m_fdbk * right + m_v[1];
             m_v[0] = left - this->m_fdbk * tmpL;
             m_v[1] = right - this->m_fdbk * tmpR;
+            flushDenormals<Denormals>(m_v[0], m_v[1]);
             if constexpr (ClampValues)
             {
                 m_v[0] = std::clamp(m_v[0], -1.f, 1.f);
@@ -259,6 +523,7 @@ public:
         {
             m_v[0] = left + this->m_fdbk * (m_v[0] - left);
             m_v[1] = right + this->m_fdbk * (m_v[1] - right);
+            flushDenormals<Denormals>(m_v[0], m_v[1]);
             if constexpr (ClampValues)
             {
                 m_v[0] = std::clamp(m_v[0], -1.f, 1.f);
@@ -272,6 +537,7 @@ public:
             const auto a0 = (1.0f + this->m_fdbk) * 0.5f;
             float outL = a0 * (left - m_x1[0]) + this->m_fdbk * m_v[0];
             float outR = a0 * (right - m_x1[1]) + this->m_fdbk * m_v[1];
+            flushDenormals<Denormals>(outL, outR);
             m_x1[0] = left;
             m_x1[1] = right;
             if constexpr (ClampValues)
@@ -303,6 +569,27 @@ public:
         }
     }
 
+    // a cutoff in Hz per sample for both channels
+    void processBlock(const float* inLeft, const float* inRight, const float* cutoff, float* outLeft, float* outRight,
+                      const size_t numSamples) noexcept
+    {
+        this->processModulated(cutoff, numSamples, [&](const size_t i)
+        {
+            stepStereo(inLeft[i], inRight[i], outLeft[i], outRight[i]);
+        });
+    }
+
+    // in place on interleaved frames
+    template <size_t NumFrames>
+    void processBlock(StereoAudioBuffer<NumFrames>& buffer) noexcept
+    {
+        auto* data = buffer.data();
+        for (size_t i = 0; i < 2 * NumFrames; i += 2)
+        {
+            stepStereo(data[i], data[i + 1], data[i], data[i + 1]);
+        }
+    }
+
     void resetImpl() noexcept
     {
         m_v[0] = m_v[1] = 0.0f;
@@ -316,83 +603,115 @@ private:
 
 
 // --- Arbitrary channel count version (MultiChannel) ---
+/*
+ * Interleaved frames, channel n in lane n. The state is a structure of arrays (one aligned array over the channels
+ * per state variable) and a frame steps all channels at once, the channel loop vectorizes.
+ * setChannelCutoff() gives a channel its own cutoff, the shared setters apply to all channels again.
+ */
 template <OnePoleFilterCharacteristic FilterCharacteristic, size_t NumChannels, bool ClampValues = false>
 class MultiChannelOnePoleFilter
-    : public OnePoleBase<MultiChannelOnePoleFilter<FilterCharacteristic, ClampValues, NumChannels>,
+    : public OnePoleBase<MultiChannelOnePoleFilter<FilterCharacteristic, NumChannels, ClampValues>,
                          FilterCharacteristic>
 {
+    using Base = OnePoleBase<MultiChannelOnePoleFilter, FilterCharacteristic>;
+
 public:
     explicit MultiChannelOnePoleFilter(const float sampleRate, const float cutoff = 100.0f) noexcept
-        : OnePoleBase<MultiChannelOnePoleFilter, FilterCharacteristic>(sampleRate)
+        : Base(sampleRate)
     {
         this->m_sampleRate = sampleRate;
-        this->setCutoff(cutoff);
-        m_v.fill(0.0f);
-        m_x1.fill(0.0f);
+        setCutoff(cutoff);
+        resetImpl();
     }
 
-    void step(float* inPlace) noexcept
+    void setCutoff(const float cutoff) noexcept
+    {
+        Base::setCutoff(cutoff);
+        m_perChannel = false;
+    }
+
+    void setCutoffFast(const float cutoff) noexcept
+    {
+        Base::setCutoffFast(cutoff);
+        m_perChannel = false;
+    }
+
+    void setFeedback(const float value) noexcept
+    {
+        Base::setFeedback(value);
+        m_perChannel = false;
+    }
+
+    void setDecayTime(const float timeInSeconds, const float fraction = 0.1f) noexcept
+    {
+        Base::setDecayTime(timeInSeconds, fraction);
+        m_perChannel = false;
+    }
+
+    // the other channels keep the shared (or their own) cutoff
+    void setChannelCutoff(const size_t channel, const float cutoff) noexcept
+    {
+        if (!m_perChannel)
+        {
+            m_feedback.fill(this->m_fdbk);
+            m_perChannel = true;
+        }
+        m_feedback[channel] = Base::cutoffToFeedback(this->m_sampleRate, cutoff);
+    }
+
+    void setChannelCutoffs(const std::array<float, NumChannels>& cutoffs) noexcept
     {
         for (size_t ch = 0; ch < NumChannels; ++ch)
         {
-            if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::AllPass)
-            {
-                const auto out = this->m_fdbk * inPlace[ch] + m_v[ch];
-                m_v[ch] = inPlace[ch] - this->m_fdbk * out;
-                if constexpr (ClampValues)
-                {
-                    m_v[ch] = std::clamp(m_v[ch], -1.f, 1.f);
-                }
-                inPlace[ch] = out;
-            }
-            else if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::LowPass)
-            {
-                m_v[ch] = inPlace[ch] + this->m_fdbk * (m_v[ch] - inPlace[ch]);
-                if constexpr (ClampValues)
-                {
-                    m_v[ch] = std::clamp(m_v[ch], -1.f, 1.f);
-                }
-                inPlace[ch] = m_v[ch];
-            }
-            else if constexpr (FilterCharacteristic == OnePoleFilterCharacteristic::HighPass)
-            {
-                const auto a0 = (1.0f + this->m_fdbk) * 0.5f;
-                float out = a0 * (inPlace[ch] - m_x1[ch]) + this->m_fdbk * m_v[ch];
-                m_x1[ch] = inPlace[ch];
-                if constexpr (ClampValues)
-                {
-                    out = std::clamp(out, -1.f, 1.f);
-                }
-                m_v[ch] = out;
-                inPlace[ch] = out;
-            }
+            m_feedback[ch] = Base::cutoffToFeedback(this->m_sampleRate, cutoffs[ch]);
         }
+        m_perChannel = true;
+    }
+
+    void step(float* inPlace) noexcept
+    {
+        stepFrame(inPlace, feedbackLanes(), m_v, m_x1);
     }
 
     void processBlock(float* inPlace, const size_t numSamples) noexcept
     {
-        if (this->m_fdbk <= 1E-8f)
+        if (!m_perChannel && std::abs(this->m_fdbk) <= 1E-8f)
         {
             return;
         }
-        for (size_t i = 0; i < numSamples; ++i)
+        processFrames(inPlace, numSamples);
+    }
+
+    void processBlock(const float* in, float* out, const size_t numSamples) noexcept
+    {
+        std::copy_n(in, numSamples * NumChannels, out);
+        if (m_perChannel || this->m_fdbk != 0)
         {
-            step(inPlace + i * NumChannels);
+            processFrames(out, numSamples);
         }
     }
 
-    void processBlock(const float* in, float* out, const size_t numSamples) noexcept
+    // in place on interleaved frames, channel n in lane n
+    template <size_t NumFrames>
+    void processBlock(AudioBuffer<NumChannels, NumFrames>& buffer) noexcept
     {
-        if (this->m_fdbk == 0)
+        processBlock(buffer.data(), NumFrames);
+    }
+
+    // interleaved frames with a cutoff in Hz per frame for all channels, in and out may be the same buffer
+    void processBlock(const float* in, const float* cutoff, float* out, const size_t numSamples) noexcept
+    {
+        if (in != out)
         {
             std::copy_n(in, numSamples * NumChannels, out);
-            return;
         }
-        for (size_t i = 0; i < numSamples; ++i)
+        m_perChannel = false;
+        Lane fdbk;
+        this->processModulated(cutoff, numSamples, [&](const size_t i)
         {
-            std::copy_n(in + i * NumChannels, NumChannels, out + i * NumChannels);
-            step(out + i * NumChannels);
-        }
+            fdbk.fill(this->m_fdbk);
+            stepFrame(out + i * NumChannels, fdbk, m_v, m_x1);
+        });
     }
 
     void resetImpl() noexcept
@@ -402,7 +721,112 @@ public:
     }
 
 private:
-    std::array<float, NumChannels> m_v{};
-    std::array<float, NumChannels> m_x1{};
+    // a divisor of NumChannels
+    static constexpr size_t ChunkLanes = NumChannels <= 16 ? NumChannels : std::gcd(NumChannels, size_t{16});
+
+    struct alignas(32) Lane : std::array<float, NumChannels>
+    {
+    };
+
+    [[nodiscard]] Lane feedbackLanes() const noexcept
+    {
+        if (m_perChannel)
+        {
+            return m_feedback;
+        }
+        Lane fdbk;
+        fdbk.fill(this->m_fdbk);
+        return fdbk;
+    }
+
+    void processFrames(float* inPlace, const size_t numFrames) noexcept
+    {
+        // local state, the compiler can not prove that inPlace does not alias the members
+        const auto fdbk = feedbackLanes();
+        auto v = m_v;
+        auto x1 = m_x1;
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            stepFrame(inPlace + i * NumChannels, fdbk, v, x1);
+        }
+        m_v = v;
+        m_x1 = x1;
+    }
+
+    // up to 16 channels at once through a local copy, the compiler can not prove that the frame doesn't alias the
+    // state. Unrolled over the chunks, the state stays at constant offsets and every chunk vectorizes.
+    static void stepFrame(float* frame, const Lane& fdbk, Lane& v, Lane& x1) noexcept
+    {
+#pragma GCC unroll 16
+        for (size_t offset = 0; offset < NumChannels; offset += ChunkLanes)
+        {
+            alignas(32) std::array<float, ChunkLanes> x;
+            std::copy_n(frame + offset, ChunkLanes, x.data());
+            stepLanes(x, offset, fdbk, v, x1);
+            std::copy_n(x.data(), ChunkLanes, frame + offset);
+        }
+    }
+
+    // x holds the channels offset ... offset + ChunkLanes - 1. The state update, the clamp and the output run as
+    // separate passes over the lanes, merged into one the clamp keeps the compiler from vectorizing the chunk.
+    static void stepLanes(std::array<float, ChunkLanes>& x, const size_t offset, const Lane& fdbk, Lane& v,
+                          Lane& x1) noexcept
+    {
+        using enum OnePoleFilterCharacteristic;
+        for (size_t k = 0; k < ChunkLanes; ++k)
+        {
+            const auto ch = offset + k;
+            if constexpr (FilterCharacteristic == AllPass)
+            {
+                const auto out = fdbk[ch] * x[k] + v[ch];
+                v[ch] = x[k] - fdbk[ch] * out;
+                x[k] = out;
+            }
+            else if constexpr (FilterCharacteristic == HighPass)
+            {
+                const auto a0 = (1.0f + fdbk[ch]) * 0.5f;
+                const auto out = a0 * (x[k] - x1[ch]) + fdbk[ch] * v[ch];
+                x1[ch] = x[k];
+                v[ch] = out;
+            }
+            else
+            {
+                v[ch] = x[k] + fdbk[ch] * (v[ch] - x[k]);
+            }
+        }
+        if constexpr (ClampValues)
+        {
+            for (size_t k = 0; k < ChunkLanes; ++k)
+            {
+                if constexpr (ChunkLanes < 4)
+                {
+                    // scalar anyway, the predicted branch keeps the clamp out of the dependency chain
+                    v[offset + k] = std::clamp(v[offset + k], -1.f, 1.f);
+                }
+                else
+                {
+                    // on the magnitude, std::clamp and min(max()) on floats compile to branches
+                    v[offset + k] = std::copysign(FastMath::clampPositive(std::abs(v[offset + k]), 0.f, 1.f),
+                                                  v[offset + k]);
+                }
+            }
+        }
+        for (size_t k = 0; k < ChunkLanes; ++k)
+        {
+            if constexpr (FilterCharacteristic == HighPassLeaky)
+            {
+                x[k] = x[k] - v[offset + k];
+            }
+            else if constexpr (FilterCharacteristic != AllPass)
+            {
+                x[k] = v[offset + k];
+            }
+        }
+    }
+
+    Lane m_v{};
+    Lane m_x1{};
+    Lane m_feedback{}; // per channel, used with m_perChannel
+    bool m_perChannel{false};
 };
 } // namespace AbacDsp
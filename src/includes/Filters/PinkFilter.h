@@ -1,7 +1,24 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <numeric>
 
+#include "Numbers/Denormals.h"
+
+// Paul Kellet's economy pink filter: three leaky integrators plus a direct path, -3 dB/octave within 0.5 dB above
+// 9.2 Hz at 44.1 kHz
+struct PinkNetwork
+{
+    static constexpr auto scale{0.05f};
+    static constexpr auto direct{0.1848f};
+    static constexpr std::array coeffsA{0.99765f, 0.96300f, 0.57000f};
+    static constexpr std::array coeffsB{0.0990460f, 0.2965164f, 1.0526913f};
+};
+
+// DenormalPolicy::Flush zeroes the state once it decays below -300 dB
+template <AbacDsp::DenormalPolicy Denormals = AbacDsp::DenormalPolicy::None>
 class PinkFilter
 {
 public:
@@ -11,14 +28,13 @@ public:
 
     float step(const float in)
     {
-        static constexpr auto scale{0.05f};
-        static constexpr std::array coeffsA{0.99765f, 0.96300f, 0.57000f};
-        static constexpr std::array coeffsB{0.0990460f, 0.2965164f, 1.0526913f};
+        using N = PinkNetwork;
         for (size_t i = 0; i < 3; ++i)
         {
-            m_v[i] = coeffsA[i] * m_v[i] + coeffsB[i] * in;
+            m_v[i] = N::coeffsA[i] * m_v[i] + N::coeffsB[i] * in;
         }
-        return (m_v[0] + m_v[1] + m_v[2] + in * 0.1848f) * scale;
+        AbacDsp::flushDenormals<Denormals>(m_v[0], m_v[1], m_v[2]);
+        return (m_v[0] + m_v[1] + m_v[2] + in * N::direct) * N::scale;
     }
 
     void processBlock(float* in, const size_t numSamples) noexcept
@@ -37,3 +53,59 @@ public:
 private:
     std::array<float, 3> m_v{};
 };
+
+/*
+ * The pink network for Lanes channels of interleaved frames, channel n in lane n, the same result per channel as
+ * PinkFilter. The state is kept per section over all lanes and a frame steps all channels at once, in chunks of up
+ * to 16 lanes through a local copy (see MultiChannelOnePoleFilter).
+ */
+template <size_t Lanes, AbacDsp::DenormalPolicy Denormals = AbacDsp::DenormalPolicy::None>
+class PinkFilterLanes
+{
+public:
+    void processFrames(float* inPlace, const size_t numFrames) noexcept
+    {
+        auto v = m_v;
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+#pragma GCC unroll 16
+            for (size_t offset = 0; offset < Lanes; offset += ChunkLanes)
+            {
+                alignas(32) std::array<float, ChunkLanes> x;
+                std::copy_n(inPlace + i * Lanes + offset, ChunkLanes, x.data());
+                stepLanes(x, offset, v);
+                std::copy_n(x.data(), ChunkLanes, inPlace + i * Lanes + offset);
+            }
+        }
+        m_v = v;
+    }
+
+    void reset() noexcept
+    {
+        m_v = {};
+    }
+
+private:
+    // a divisor of Lanes
+    static constexpr size_t ChunkLanes = Lanes <= 16 ? Lanes : std::gcd(Lanes, size_t{16});
+
+    struct alignas(32) Lane : std::array<float, Lanes>
+    {
+    };
+
+    static void stepLanes(std::array<float, ChunkLanes>& x, const size_t offset, std::array<Lane, 3>& v) noexcept
+    {
+        using N = PinkNetwork;
+        for (size_t k = 0; k < ChunkLanes; ++k)
+        {
+            const auto l = offset + k;
+            v[0][l] = N::coeffsA[0] * v[0][l] + N::coeffsB[0] * x[k];
+            v[1][l] = N::coeffsA[1] * v[1][l] + N::coeffsB[1] * x[k];
+            v[2][l] = N::coeffsA[2] * v[2][l] + N::coeffsB[2] * x[k];
+            AbacDsp::flushDenormals<Denormals>(v[0][l], v[1][l], v[2][l]);
+            x[k] = (v[0][l] + v[1][l] + v[2][l] + x[k] * N::direct) * N::scale;
+        }
+    }
+
+    std::array<Lane, 3> m_v{};
+};
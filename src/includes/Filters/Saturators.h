@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <numbers>
+
+#include "Numbers/FastMath.h"
+
+namespace AbacDsp
+{
+/*
+ * Odd saturation curves for feedback paths (e.g. the ladder filters), picked as a template policy.
+ * process() is a branch free approximation that vectorizes when inlined into a lane loop, reference() the exact
+ * curve in double for comparisons.
+ *
+ * +---------------------+------------------------------+---------------------+-----------+----------------------+
+ * | Policy              | Formula                      | Shape               | CPU       | process() abs. error |
+ * +---------------------+------------------------------+---------------------+-----------+----------------------+
+ * | SqrtSaturator       | x / sqrt(1 + x^2)            | Soft, arcsine-like  | medium    | rounding             |
+ * | FastSqrtSaturator   | x / sqrt(1 + x^2)            | Soft, arcsine-like  | medium    | < 5E-7               |
+ * | TanhSaturator       | tanh(x)                      | Soft, classic       | medium    | < 1E-6               |
+ * | AtanSaturator       | (2/pi) * atan(x)             | Soft, slowest knee  | medium    | < 1E-6               |
+ * | CubicSaturator      | x - (1/3)x^3  (clamp -1..1)  | Soft, analog-like   | very fast | rounding             |
+ * | ReciprocalSaturator | x / (1 + abs(x))             | Soft (different)    | fast      | rounding             |
+ * | HardClipSaturator   | clamp(x, -1, 1)              | Hard                | fastest   | exact                |
+ * +---------------------+------------------------------+---------------------+-----------+----------------------+
+ */
+template <typename T>
+concept Saturator = requires(const float x, const double r) {
+    { T::process(x) } -> std::same_as<float>;
+    { T::reference(r) } -> std::same_as<double>;
+};
+
+// std::sqrt is a single instruction, fastest in scalar code, but may set errno and keeps lane loops from vectorizing
+struct SqrtSaturator
+{
+    static float process(const float x)
+    {
+        return x / std::sqrt(1.f + x * x);
+    }
+
+    static double reference(const double x)
+    {
+        return x / std::sqrt(1. + x * x);
+    }
+
+    static double antiderivative1(const double x)
+    {
+        return std::sqrt(1. + x * x);
+    }
+
+    static double antiderivative2(const double x)
+    {
+        return (x * std::sqrt(1. + x * x) + std::asinh(x)) / 2.;
+    }
+};
+
+// the same curve for lane loops (banks)
+struct FastSqrtSaturator
+{
+    static float process(const float x)
+    {
+        return x * FastMath::invSqrt(1.f + x * x);
+    }
+
+    static double reference(const double x)
+    {
+        return SqrtSaturator::reference(x);
+    }
+
+    static double antiderivative1(const double x)
+    {
+        return SqrtSaturator::antiderivative1(x);
+    }
+
+    static double antiderivative2(const double x)
+    {
+        return SqrtSaturator::antiderivative2(x);
+    }
+};
+
+struct TanhSaturator
+{
+    // (1 - e^-2|x|) / (1 + e^-2|x|) with the sign of x, exactly odd. |x| is clamped to 10 (tanh is 1 in float from
+    // about 9 on), so a blown up ladder saturates and exp2() stays in range, NaN saturates as well.
+    static float process(const float x)
+    {
+        const auto t = FastMath::exp2(-2.f * std::numbers::log2e_v<float> * std::min(10.f, std::abs(x)));
+        return std::copysign((1.f - t) / (1.f + t), x);
+    }
+
+    static double reference(const double x)
+    {
+        return std::tanh(x);
+    }
+
+    // log(cosh(x)) without overflow. The second antiderivative needs the dilogarithm: no second order ADAA.
+    static double antiderivative1(const double x)
+    {
+        const auto a = std::abs(x);
+        return a + std::log1p(std::exp(-2. * a)) - std::numbers::ln2;
+    }
+};
+
+struct AtanSaturator
+{
+    static float process(const float x)
+    {
+        return 2.f / std::numbers::pi_v<float> * FastMath::atan2(x, 1.f);
+    }
+
+    static double reference(const double x)
+    {
+        return 2. / std::numbers::pi * std::atan(x);
+    }
+
+    static double antiderivative1(const double x)
+    {
+        return 2. / std::numbers::pi * (x * std::atan(x) - 0.5 * std::log1p(x * x));
+    }
+
+    static double antiderivative2(const double x)
+    {
+        return 2. / std::numbers::pi * (0.5 * (x * x - 1.) * std::atan(x) + 0.5 * x - 0.5 * x * std::log1p(x * x));
+    }
+};
+
+// saturates at +-2/3
+struct CubicSaturator
+{
+    static float process(const float x)
+    {
+        const auto c = std::min(std::max(x, -1.f), 1.f);
+        return c - c * c * c * (1.f / 3.f);
+    }
+
+    static double reference(const double x)
+    {
+        const auto c = std::clamp(x, -1., 1.);
+        return c - c * c * c / 3.;
+    }
+
+    static double antiderivative1(const double x)
+    {
+        const auto a = std::abs(x);
+        return a <= 1. ? x * x / 2. - x * x * x * x / 12. : 2. / 3. * a - 0.25;
+    }
+
+    static double antiderivative2(const double x)
+    {
+        const auto a = std::abs(x);
+        return a <= 1. ? x * x * x / 6. - x * x * x * x * x / 60. : std::copysign(a * a / 3. - a / 4. + 1. / 15., x);
+    }
+};
+
+struct ReciprocalSaturator
+{
+    static float process(const float x)
+    {
+        return x / (1.f + std::abs(x));
+    }
+
+    static double reference(const double x)
+    {
+        return x / (1. + std::abs(x));
+    }
+
+    static double antiderivative1(const double x)
+    {
+        const auto a = std::abs(x);
+        return a - std::log1p(a);
+    }
+
+    static double antiderivative2(const double x)
+    {
+        const auto a = std::abs(x);
+        return std::copysign(a * a / 2. + a - (1. + a) * std::log1p(a), x);
+    }
+};
+
+struct HardClipSaturator
+{
+    // min/max instead of std::clamp, which compiles to branches
+    static float process(const float x)
+    {
+        return std::min(std::max(x, -1.f), 1.f);
+    }
+
+    static double reference(const double x)
+    {
+        return std::clamp(x, -1., 1.);
+    }
+
+    static double antiderivative1(const double x)
+    {
+        const auto a = std::abs(x);
+        return a <= 1. ? x * x / 2. : a - 0.5;
+    }
+
+    static double antiderivative2(const double x)
+    {
+        const auto a = std::abs(x);
+        return a <= 1. ? x * x * x / 6. : std::copysign(a * a / 2. - a / 2. + 1. / 6., x);
+    }
+};
+
+template <typename T, size_t Order>
+concept AntiderivativeSaturator =
+    Saturator<T> && (Order < 1 || requires(const double x) {
+        { T::antiderivative1(x) } -> std::same_as<double>;
+    }) && (Order < 2 || requires(const double x) {
+        { T::antiderivative2(x) } -> std::same_as<double>;
+    });
+
+/*
+ * Antiderivative anti-aliasing of a saturation curve f with antiderivatives F1, F2 (Parker, Zavalishin, Le Bivic:
+ * "Reducing the aliasing of nonlinear waveshaping using continuous-time convolution", DAFx 2016).
+ * The output is the average of f over the straight line between successive inputs, which suppresses the high
+ * harmonics before they fold back, at base rate:
+ *   Order 1: (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1]), half a sample of delay
+ *   Order 2: 2 / (x[n] - x[n-2]) * (D(x[n], x[n-1]) - D(x[n-1], x[n-2])), D(a, b) = (F2(a) - F2(b)) / (a - b),
+ *            one sample of delay, stronger suppression
+ * Computed in double, the divided differences cancel. For nearly equal inputs the limits are taken.
+ * Order 0 is the plain curve, stateless.
+ */
+template <Saturator S, size_t Order>
+    requires(Order <= 2 && AntiderivativeSaturator<S, Order>)
+class AdaaSaturator
+{
+public:
+    AdaaSaturator()
+    {
+        reset();
+    }
+
+    float process(const float in)
+    {
+        const auto x = static_cast<double>(in);
+        if constexpr (Order == 1)
+        {
+            const auto a0 = S::antiderivative1(x);
+            const auto dx = x - m_x1;
+            const auto y = std::abs(dx) < EPSILON ? S::reference((x + m_x1) / 2) : (a0 - m_a1) / dx;
+            m_x1 = x;
+            m_a1 = a0;
+            return static_cast<float>(y);
+        }
+        else
+        {
+            const auto a0 = S::antiderivative2(x);
+            const auto d0 = differenceQuotient(x, m_x1, a0, m_a1);
+            double y;
+            if (std::abs(x - m_x2) < EPSILON)
+            {
+                const auto mean = (x + m_x2) / 2;
+                const auto delta = mean - m_x1;
+                y = std::abs(delta) < EPSILON
+                        ? S::reference((mean + m_x1) / 2)
+                        : 2. / delta * (S::antiderivative1(mean) + (m_a1 - S::antiderivative2(mean)) / delta);
+            }
+            else
+            {
+                y = 2. * (d0 - m_d1) / (x - m_x2);
+            }
+            m_x2 = m_x1;
+            m_x1 = x;
+            m_a1 = a0;
+            m_d1 = d0;
+            return static_cast<float>(y);
+        }
+    }
+
+    void reset()
+    {
+        m_x1 = m_x2 = 0.;
+        if constexpr (Order == 1)
+        {
+            m_a1 = S::antiderivative1(0.);
+        }
+        else
+        {
+            m_a1 = S::antiderivative2(0.);
+            m_d1 = S::antiderivative1(0.);
+        }
+    }
+
+private:
+    static constexpr double EPSILON{1E-5};
+
+    // (F2(a) - F2(b)) / (a - b), F1 of the mean for a ~ b
+    static double differenceQuotient(const double a, const double b, const double f2a, const double f2b)
+    {
+        return std::abs(a - b) < EPSILON ? S::antiderivative1((a + b) / 2) : (f2a - f2b) / (a - b);
+    }
+
+    double m_x1{0.};
+    double m_x2{0.};
+    double m_a1{0.}; // antiderivative of the order at x[n-1]
+    double m_d1{0.}; // D(x[n-1], x[n-2])
+};
+
+template <Saturator S>
+class AdaaSaturator<S, 0>
+{
+public:
+    static float process(const float in)
+    {
+        return S::process(in);
+    }
+
+    void reset()
+    {
+    }
+};
+}
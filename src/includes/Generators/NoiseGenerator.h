@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <type_traits>
+
+#include "Audio/AudioBuffer.h"
+#include "Filters/OnePoleFilter.h"
+#include "Filters/PinkFilter.h"
+#include "Numbers/Random.h"
+
+namespace AbacDsp
+{
+enum class NoiseColor
+{
+    White,       // uniform in [-1, 1)
+    Pink,        // white through the pink network of PinkFilter, -3 dB/octave
+    Brown,       // white through a leaky integrator, -6 dB/octave above BROWN_CORNER, RMS 0.25
+    BandLimited, // white through a one pole low pass at setCutoff(), like NaiveDsp::Generator<Wave::Noise>
+};
+
+/*
+ * Noise for NumChannels independent channels in blocks of interleaved frames. The white noise is drawn in bulk from
+ * RandomLanes, the coloring runs per frame over all channels in SIMD lanes (PinkFilterLanes,
+ * MultiChannelOnePoleFilter). The same seed renders the same noise.
+ */
+template <NoiseColor Color, size_t NumChannels = 1>
+class NoiseGenerator
+{
+public:
+    static constexpr size_t RANDOM_LANES{8};
+    static constexpr float BROWN_CORNER{8.f};
+    static constexpr float BROWN_RMS{0.25f};
+
+    explicit NoiseGenerator(const float sampleRate, const uint64_t seed = RandomLanes<RANDOM_LANES>::DEFAULT_SEED)
+        : m_random(seed)
+        , m_lowpass(sampleRate, Color == NoiseColor::Brown ? BROWN_CORNER : 1000.f)
+    {
+        if constexpr (Color == NoiseColor::Brown)
+        {
+            // the low pass has the variance (1 - p) / (1 + p) of its input, uniform white noise 1 / 3
+            const auto p = Lowpass::cutoffToFeedback(sampleRate, BROWN_CORNER);
+            m_brownGain = BROWN_RMS * std::numbers::sqrt3_v<float> * std::sqrt((1.f + p) / (1.f - p));
+        }
+    }
+
+    void setCutoff(const float cutoff) noexcept
+        requires(Color == NoiseColor::BandLimited)
+    {
+        m_lowpass.setCutoff(cutoff);
+    }
+
+    // restarts the noise sequence of the seed
+    void seed(const uint64_t seed) noexcept
+    {
+        m_random.seed(seed);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        m_pink.reset();
+        m_lowpass.reset();
+    }
+
+    // numFrames interleaved frames of NumChannels
+    void render(float* out, const size_t numFrames) noexcept
+    {
+        const auto numSamples = numFrames * NumChannels;
+        m_random.fillBipolar(out, numSamples);
+        if constexpr (Color == NoiseColor::Pink)
+        {
+            m_pink.processFrames(out, numFrames);
+        }
+        else if constexpr (Color == NoiseColor::Brown)
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                out[i] *= m_brownGain;
+            }
+            m_lowpass.processBlock(out, numFrames);
+        }
+        else if constexpr (Color == NoiseColor::BandLimited)
+        {
+            m_lowpass.processBlock(out, numFrames);
+        }
+    }
+
+    template <size_t NumFrames>
+    void render(AudioBuffer<NumChannels, NumFrames>& buffer) noexcept
+    {
+        render(buffer.data(), NumFrames);
+    }
+
+private:
+    using Lowpass = MultiChannelOnePoleFilter<OnePoleFilterCharacteristic::LowPass, NumChannels>;
+
+    struct Unused
+    {
+        void reset() noexcept
+        {
+        }
+    };
+
+    RandomLanes<RANDOM_LANES> m_random;
+    [[no_unique_address]] std::conditional_t<Color == NoiseColor::Pink, PinkFilterLanes<NumChannels>, Unused> m_pink;
+    Lowpass m_lowpass; // Brown and BandLimited
+    float m_brownGain{1.f};
+};
+}
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <concepts>
+#include <cstdint>
 #include <iterator>
 #include <numbers>
-#include <random>
 #include <stdexcept>
 #include <vector>
 #include "Filters/OnePoleFilter.h"
+#include "Numbers/FastMath.h"
+#include "Numbers/Random.h"
 
 namespace NaiveDsp
 {
@@ -23,18 +28,17 @@ template <Wave Style>
 class Generator
 {
   public:
-    explicit Generator(const float sampleRate, const float frequency = 440.f)
+    // seed: for Noise, the same seed gives the same noise
+    explicit Generator(const float sampleRate, const float frequency = 440.f,
+                       const uint64_t seed = AbacDsp::RandomLanes<1>::DEFAULT_SEED)
         : m_sampleRate(sampleRate)
         , m_frequency(frequency)
         , m_phase(0.0f)
         , m_lastNoise(0.0f)
+        , m_rng(seed)
         , m_lowpass(sampleRate)
     {
         m_advance = m_frequency / m_sampleRate;
-        if constexpr (Style == Wave::Noise)
-        {
-            m_rng.seed(std::random_device{}());
-        }
     }
 
     float step()
@@ -65,14 +69,58 @@ class Generator
         }
         else if constexpr (Style == Wave::Noise)
         {
-            std::uniform_real_distribution dist(-1.0f, 1.0f);
+            float noise;
+            m_rng.fillBipolar(&noise, 1);
             m_lowpass.setCutoff(m_frequency);
-            float filtered = m_lowpass.step(dist(m_rng));
+            float filtered = m_lowpass.step(noise);
             advancePhase();
             return filtered;
         }
     }
 
+    // numFrames interleaved frames of numChannels, every channel the same signal. The phases of Lanes samples
+    // advance at once and the wave is a branch free kernel (the sine by FastMath::sin2Pi), the lane loop vectorizes.
+    void renderBlock(float* out, const size_t numFrames, const size_t numChannels = 1)
+    {
+        if (numChannels == 1)
+        {
+            renderMono(out, numFrames);
+            return;
+        }
+        std::array<float, CHUNK_SIZE> chunk;
+        for (size_t offset = 0; offset < numFrames; offset += CHUNK_SIZE)
+        {
+            const auto count = std::min(CHUNK_SIZE, numFrames - offset);
+            renderMono(chunk.data(), count);
+            auto* frames = out + offset * numChannels;
+            if (numChannels == 2)
+            {
+                interleave<2>(chunk.data(), count, frames);
+            }
+            else
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    std::fill_n(frames + i * numChannels, numChannels, chunk[i]);
+                }
+            }
+        }
+    }
+
+    // numFrames into each of numChannels separate buffers
+    void renderPlanar(float* const* channels, const size_t numChannels, const size_t numFrames)
+    {
+        if (numChannels == 0)
+        {
+            return;
+        }
+        renderMono(channels[0], numFrames);
+        for (size_t ch = 1; ch < numChannels; ++ch)
+        {
+            std::copy_n(channels[0], numFrames, channels[ch]);
+        }
+    }
+
     template <typename FloatIt>
     void render(FloatIt begin, FloatIt end, const size_t numChannels = 1)
     {
@@ -84,10 +132,16 @@ class Generator
     {
         if (numChannels == 0)
             throw std::invalid_argument("numChannels can not be 0");
-        if (const auto count = static_cast<size_t>(std::distance(begin, end)); count % numChannels != 0)
+        const auto count = static_cast<size_t>(std::distance(begin, end));
+        if (count % numChannels != 0)
             throw std::invalid_argument("Iterator range size must be a multiple of numChannels");
         m_frequency = frequency;
         m_advance = m_frequency / m_sampleRate;
+        if constexpr (std::contiguous_iterator<FloatIt> && std::same_as<std::iter_value_t<FloatIt>, float>)
+        {
+            renderBlock(std::to_address(begin), count / numChannels, numChannels);
+            return;
+        }
         while (begin != end)
         {
             float value = step();
@@ -99,6 +153,80 @@ class Generator
     }
 
   private:
+    static constexpr size_t LANES{8};
+    static constexpr size_t CHUNK_SIZE{64};
+
+    // phase >= 0 into [0, 1), truncation is floor
+    static float wrap(const float phase) noexcept
+    {
+        return phase - static_cast<float>(static_cast<int32_t>(phase));
+    }
+
+    // the wave of step() at a phase in [0, 1)
+    static float shape(const float phase) noexcept
+    {
+        if constexpr (Style == Wave::Sine)
+        {
+            return FastMath::sin2Pi(phase);
+        }
+        else if constexpr (Style == Wave::Saw)
+        {
+            return 2.0f * (phase - 0.5f);
+        }
+        else if constexpr (Style == Wave::Triangle)
+        {
+            return 2.0f * std::abs(2.0f * (phase - static_cast<float>(static_cast<int32_t>(phase + 0.5f)))) - 1.0f;
+        }
+        else
+        {
+            return phase < 0.5f ? 1.0f : -1.0f;
+        }
+    }
+
+    void renderMono(float* out, const size_t numSamples)
+    {
+        if constexpr (Style == Wave::Noise)
+        {
+            m_rng.fillBipolar(out, numSamples);
+            m_lowpass.setCutoff(m_frequency);
+            m_lowpass.processBlock(out, numSamples);
+        }
+        else
+        {
+            // sample l of a step at phase + l * advance, local copies so the stores into out can't alias them
+            const auto advance = m_advance;
+            auto phase = m_phase;
+            size_t i = 0;
+            for (; i + LANES <= numSamples; i += LANES)
+            {
+                for (size_t l = 0; l < LANES; ++l)
+                {
+                    out[i + l] = shape(wrap(phase + static_cast<float>(l) * advance));
+                }
+                phase = wrap(phase + static_cast<float>(LANES) * advance);
+            }
+            const auto rest = numSamples - i; // less than LANES
+            for (size_t l = 0; l < rest; ++l)
+            {
+                out[i + l] = shape(phase);
+                phase = wrap(phase + advance);
+            }
+            m_phase = phase;
+        }
+    }
+
+    template <size_t NumChannels>
+    static void interleave(const float* in, const size_t numFrames, float* out) noexcept
+    {
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            for (size_t ch = 0; ch < NumChannels; ++ch)
+            {
+                out[i * NumChannels + ch] = in[i];
+            }
+        }
+    }
+
     void advancePhase()
     {
         m_phase += m_advance;
@@ -109,7 +237,9 @@ class Generator
     }
 
     float m_sampleRate, m_frequency, m_phase, m_advance, m_lastNoise;
-    std::mt19937 m_rng;
-    AbacDsp::OnePoleFilter<AbacDsp::OnePoleFilterCharacteristic::LowPass, false> m_lowpass;
+    AbacDsp::RandomLanes<1> m_rng;
+    // the scan kernel for the noise blocks of renderBlock()
+    AbacDsp::OnePoleFilter<AbacDsp::OnePoleFilterCharacteristic::LowPass, false, AbacDsp::DenormalPolicy::None, LANES>
+        m_lowpass;
 };
 }
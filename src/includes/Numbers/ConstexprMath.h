@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+// Math functions usable in constant expressions, for filter designs computed at compile time.
+// At runtime they forward to <cmath>, so runtime designs are unchanged. In constant evaluation they use series in
+// double precision (relative error around 1E-15), good enough for float coefficients.
+namespace ConstexprMath
+{
+namespace detail
+{
+constexpr double sqrt(const double x)
+{
+    if (x <= 0 || x == std::numeric_limits<double>::infinity())
+    {
+        return x == 0 || x > 0 ? x : std::numeric_limits<double>::quiet_NaN();
+    }
+    // scale into [1, 4) by powers of 4, Newton from there
+    double scale = 1;
+    double m = x;
+    while (m >= 4)
+    {
+        m /= 4;
+        scale *= 2;
+    }
+    while (m < 1)
+    {
+        m *= 4;
+        scale /= 2;
+    }
+    double r = 1.5;
+    for (int i = 0; i < 8; ++i)
+    {
+        r = 0.5 * (r + m / r);
+    }
+    return r * scale;
+}
+
+constexpr double exp(const double x)
+{
+    if (x > 709.8)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    if (x < -745.2)
+    {
+        return 0;
+    }
+    // x = k * ln2 + r with |r| <= ln2 / 2
+    const auto k = static_cast<int64_t>(x / std::numbers::ln2 + (x < 0 ? -0.5 : 0.5));
+    const auto r = x - static_cast<double>(k) * std::numbers::ln2;
+    double term = 1;
+    double sum = 1;
+    for (int n = 1; n < 24; ++n)
+    {
+        term *= r / n;
+        sum += term;
+    }
+    for (int64_t i = 0; i < k; ++i)
+    {
+        sum *= 2;
+    }
+    for (int64_t i = 0; i > k; --i)
+    {
+        sum /= 2;
+    }
+    return sum;
+}
+
+constexpr double log(const double x)
+{
+    if (x <= 0)
+    {
+        return x == 0 ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+    }
+    if (x == std::numeric_limits<double>::infinity())
+    {
+        return x;
+    }
+    // x = m * 2^k with m in [sqrt(1/2), sqrt(2)), log(m) = 2 * atanh((m - 1) / (m + 1))
+    double m = x;
+    int k = 0;
+    while (m >= std::numbers::sqrt2)
+    {
+        m /= 2;
+        ++k;
+    }
+    while (m < std::numbers::sqrt2 / 2)
+    {
+        m *= 2;
+        --k;
+    }
+    const auto s = (m - 1) / (m + 1);
+    const auto s2 = s * s;
+    double power = s;
+    double sum = 0;
+    for (int n = 1; n < 40; n += 2)
+    {
+        sum += power / n;
+        power *= s2;
+    }
+    return 2 * sum + k * std::numbers::ln2;
+}
+
+// argument reduced to [-pi, pi]
+constexpr double reduce(const double x)
+{
+    const auto twoPi = 2 * std::numbers::pi;
+    const auto k = static_cast<int64_t>(x / twoPi + (x < 0 ? -0.5 : 0.5));
+    return x - static_cast<double>(k) * twoPi;
+}
+
+constexpr double sin(const double x)
+{
+    const auto r = reduce(x);
+    const auto r2 = r * r;
+    double term = r;
+    double sum = r;
+    for (int n = 1; n < 20; ++n)
+    {
+        term *= -r2 / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cos(const double x)
+{
+    const auto r = reduce(x);
+    const auto r2 = r * r;
+    double term = 1;
+    double sum = 1;
+    for (int n = 1; n < 20; ++n)
+    {
+        term *= -r2 / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T abs(const T x)
+{
+    return x < 0 ? -x : x;
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T sqrt(const T x)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<T>(detail::sqrt(x));
+    }
+    return std::sqrt(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T exp(const T x)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<T>(detail::exp(x));
+    }
+    return std::exp(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T log(const T x)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<T>(detail::log(x));
+    }
+    return std::log(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T pow(const T base, const T exponent)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<T>(detail::exp(exponent * detail::log(base)));
+    }
+    return std::pow(base, exponent);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T sin(const T x)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<T>(detail::sin(x));
+    }
+    return std::sin(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T cos(const T x)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<T>(detail::cos(x));
+    }
+    return std::cos(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T tan(const T x)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<T>(detail::sin(x) / detail::cos(x));
+    }
+    return std::tan(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T sinh(const T x)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<T>((detail::exp(x) - detail::exp(-x)) / 2);
+    }
+    return std::sinh(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T cosh(const T x)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<T>((detail::exp(x) + detail::exp(-x)) / 2);
+    }
+    return std::cosh(x);
+}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define ABACDSP_DENORMALS_SSE 1
+#elif defined(__aarch64__)
+#define ABACDSP_DENORMALS_ARM64 1
+#endif
+
+namespace AbacDsp
+{
+/*
+ * Recursive filter state decays into subnormal numbers once the input goes silent, and on x86 every operation on
+ * those costs a microcode assist (~100 cycles). Two remedies:
+ * - ScopedNoDenormals around the audio callback: the CPU treats subnormals as zero (FTZ/DAZ on SSE, FZ on arm64)
+ * - DenormalPolicy::Flush on a filter: its state is set to 0 below DENORMAL_THRESHOLD each step, for code that
+ *   doesn't own the thread's floating point mode (plugins in a foreign host, library code)
+ */
+enum class DenormalPolicy
+{
+    None,
+    Flush,
+};
+
+// -300 dB, far below any audible or 24 bit representable level, far above the subnormal range (< 1.2E-38)
+inline constexpr float DENORMAL_THRESHOLD = 1E-15f;
+
+// 0 for |x| < DENORMAL_THRESHOLD, a compare and select that vectorizes
+[[nodiscard]] inline float flushDenormal(const float x)
+{
+    return std::abs(x) < DENORMAL_THRESHOLD ? 0.f : x;
+}
+
+// flushes all state variables with DenormalPolicy::Flush, no-op with None
+template <DenormalPolicy Policy, typename... T>
+inline void flushDenormals(T&... state)
+{
+    if constexpr (Policy == DenormalPolicy::Flush)
+    {
+        ((state = flushDenormal(state)), ...);
+    }
+}
+
+/*
+ * Sets flush to zero and denormals are zero for the current thread for its lifetime, restores the previous mode on
+ * destruction. A no-op on platforms without such a mode.
+ */
+class ScopedNoDenormals
+{
+public:
+    ScopedNoDenormals()
+    {
+#if defined(ABACDSP_DENORMALS_SSE)
+        m_previous = _mm_getcsr();
+        _mm_setcsr(static_cast<unsigned int>(m_previous | FTZ_DAZ));
+#elif defined(ABACDSP_DENORMALS_ARM64)
+        uint64_t fpcr;
+        asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+        m_previous = fpcr;
+        fpcr |= FZ;
+        asm volatile("msr fpcr, %0" : : "r"(fpcr));
+#endif
+    }
+
+    ~ScopedNoDenormals()
+    {
+#if defined(ABACDSP_DENORMALS_SSE)
+        _mm_setcsr(static_cast<unsigned int>(m_previous));
+#elif defined(ABACDSP_DENORMALS_ARM64)
+        asm volatile("msr fpcr, %0" : : "r"(m_previous));
+#endif
+    }
+
+    ScopedNoDenormals(const ScopedNoDenormals&) = delete;
+    ScopedNoDenormals& operator=(const ScopedNoDenormals&) = delete;
+
+    // whether this platform has a mode to switch, otherwise only DenormalPolicy::Flush helps
+    static constexpr bool isSupported()
+    {
+#if defined(ABACDSP_DENORMALS_SSE) || defined(ABACDSP_DENORMALS_ARM64)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+#if defined(ABACDSP_DENORMALS_SSE)
+    static constexpr uint64_t FTZ_DAZ = 0x8040; // bit 15 flush to zero, bit 6 denormals are zero
+#elif defined(ABACDSP_DENORMALS_ARM64)
+    static constexpr uint64_t FZ = 1ull << 24;
+#endif
+    [[maybe_unused]] uint64_t m_previous{0};
+};
+}
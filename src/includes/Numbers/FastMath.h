@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+// Branch free float approximations for per sample parameter work (filter coefficients, gains). Inlined into a loop
+// over arrays they vectorize, the libm functions don't. Errors are relative and hold over the documented range.
+namespace FastMath
+{
+// clamp for 0 <= lo <= hi on the bit patterns, which order like the values for positive floats. Negative x maps to
+// lo, NaN to hi. std::clamp on floats is a branch the compiler threads through following code, which then no longer
+// vectorizes.
+[[nodiscard]] inline float clampPositive(const float x, const float lo, const float hi)
+{
+    return std::bit_cast<float>(
+        std::clamp(std::bit_cast<int32_t>(x), std::bit_cast<int32_t>(lo), std::bit_cast<int32_t>(hi)));
+}
+
+// tan(pi * x) for x in [0, 0.5), the warped frequency of the bilinear transform with x = f / sampleRate.
+// [5/4] Pade approximant of tan on [0, pi/4], above that tan(pi * x) = 1 / tan(pi * (0.5 - x)).
+// Relative error < 3E-7 (float rounding dominates).
+[[nodiscard]] inline float tanPi(const float x)
+{
+    const auto isLow = x <= 0.25f;
+    const auto y = std::numbers::pi_v<float> * std::min(x, 0.5f - x);
+    const auto y2 = y * y;
+    const auto n = y * (945.f + y2 * (-105.f + y2));
+    const auto d = 945.f + y2 * (-420.f + y2 * 15.f);
+    // select before dividing, a conditional divide keeps the loop from vectorizing
+    const auto numerator = isLow ? n : d;
+    const auto denominator = isLow ? d : n;
+    return numerator / denominator;
+}
+
+// 2^x for x in [-126, 127], relative error < 3E-7. Outside the exponent saturates, for any x (inf and NaN as well).
+[[nodiscard]] inline float exp2(const float input)
+{
+    // in range of the int conversion, NaN maps to the upper bound
+    const auto x = std::max(-127.f, std::min(128.f, input));
+    // round to nearest, the polynomial covers [-0.5, 0.5]
+    const auto shifted = x + 0.5f;
+    const auto truncated = static_cast<int32_t>(shifted);
+    const auto whole = truncated - static_cast<int32_t>(static_cast<float>(truncated) > shifted); // floor
+    const auto f = x - static_cast<float>(whole);
+    // weighted least squares fit of 2^f, relative error 7.5E-8
+    const auto p =
+        1.00000007f +
+        f * (0.693146967f + f * (0.240221197f + f * (0.0555071351f + f * (0.00967554072f + f * 0.00132763955f))));
+    // clamped as integer, see clampPositive()
+    return p * std::bit_cast<float>(static_cast<uint32_t>(std::clamp(whole, -126, 127) + 127) << 23);
+}
+
+// 10^x for x in [-37, 38], relative error < 2E-6 for |x| < 5, 1E-5 above (rounding of x * log2(10))
+[[nodiscard]] inline float pow10(const float x)
+{
+    return exp2(x * std::numbers::ln10_v<float> / std::numbers::ln2_v<float>);
+}
+
+// gain factor of a dB value, see Convert::dbToGain
+[[nodiscard]] inline float dbToGain(const float dB)
+{
+    return pow10(dB / 20.f);
+}
+
+// log2(x) for normal x > 0, error < 2E-7 * max(1, |log2(x)|) (float rounding dominates).
+// x = m * 2^e with m in [sqrt(1/2), sqrt(2)), log2(m) = 2 / ln2 * atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172.
+[[nodiscard]] inline float log2(const float x)
+{
+    const auto bits = std::bit_cast<int32_t>(x);
+    // mantissa in [1, 2), halved above sqrt(2)
+    const auto mantissaBits = (bits & 0x007fffff) | 0x3f800000;
+    const auto isHigh = static_cast<int32_t>(mantissaBits > 0x3fb504f3);
+    const auto m = std::bit_cast<float>(mantissaBits - (isHigh << 23));
+    const auto e = static_cast<float>(((bits >> 23) & 0xff) - 127 + isHigh);
+    const auto s = (m - 1.f) / (m + 1.f);
+    const auto s2 = s * s;
+    const auto series = s * (1.f + s2 * (1.f / 3.f + s2 * (1.f / 5.f + s2 * (1.f / 7.f + s2 * (1.f / 9.f)))));
+    return e + 2.f / std::numbers::ln2_v<float> * series;
+}
+
+// 1 / sqrt(x) for normal x > 0, relative error < 5E-7. Estimate from the bit pattern, three Newton steps.
+// std::sqrt may set errno, a loop calling it doesn't vectorize.
+[[nodiscard]] inline float invSqrt(const float x)
+{
+    auto y = std::bit_cast<float>(0x5f375a86 - (std::bit_cast<int32_t>(x) >> 1));
+    const auto halfX = 0.5f * x;
+    for (int i = 0; i < 3; ++i)
+    {
+        y *= 1.5f - halfX * y * y;
+    }
+    return y;
+}
+
+// 10 * log10 of a power (|H|^2), clamped to -300 dB for 0
+[[nodiscard]] inline float powerToDb(const float power)
+{
+    constexpr auto scale = 10.f * std::numbers::ln2_v<float> / std::numbers::ln10_v<float>;
+    return scale * log2(std::max(power, 1E-30f));
+}
+
+// atan2(y, x), absolute error < 1E-6 rad, 0 for (0, 0). The argument is reduced to t = min / max in [0, 1], above
+// tan(pi / 12) further by atan(t) = pi / 6 + atan((sqrt(3) t - 1) / (t + sqrt(3))), leaving a short series.
+[[nodiscard]] inline float atan2(const float y, const float x)
+{
+    constexpr auto sqrt3 = std::numbers::sqrt3_v<float>;
+    const auto ax = std::abs(x);
+    const auto ay = std::abs(y);
+    const auto isSteep = ay > ax;
+    const auto t = std::min(ax, ay) / std::max(std::max(ax, ay), 1E-30f);
+    const auto isReduced = t > 2.f - sqrt3;
+    const auto r = isReduced ? (sqrt3 * t - 1.f) / (t + sqrt3) : t;
+    const auto r2 = r * r;
+    const auto series =
+        r * (1.f + r2 * (-1.f / 3.f + r2 * (1.f / 5.f + r2 * (-1.f / 7.f + r2 * (1.f / 9.f - r2 * (1.f / 11.f))))));
+    auto angle = isReduced ? std::numbers::pi_v<float> / 6.f + series : series;
+    angle = isSteep ? std::numbers::pi_v<float> / 2.f - angle : angle;
+    angle = x < 0.f ? std::numbers::pi_v<float> - angle : angle;
+    return y < 0.f ? -angle : angle;
+}
+
+// sin(2 pi x) for x >= -0.5 (a phase), absolute error < 2E-7. Reduced to y = x - round(x) in [-0.5, 0.5), folded by
+// sin(2 pi y) = sin(2 pi (0.5 - y)) into [-0.25, 0.25] and a Taylor series to t^11 of t = 2 pi y.
+[[nodiscard]] inline float sin2Pi(const float x)
+{
+    const auto y = x - static_cast<float>(static_cast<int32_t>(x + 0.5f)); // truncation is floor for x >= -0.5
+    const auto a = std::abs(y);
+    const auto t = 2.f * std::numbers::pi_v<float> * std::copysign(std::min(a, 0.5f - a), y);
+    const auto t2 = t * t;
+    const auto high = 1.f / 362880.f - t2 * (1.f / 39916800.f);
+    return t * (1.f + t2 * (-1.f / 6.f + t2 * (1.f / 120.f + t2 * (-1.f / 5040.f + t2 * high))));
+}
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace AbacDsp
+{
+// splitmix64, expands a seed into well mixed state words
+[[nodiscard]] constexpr uint64_t splitMix64(uint64_t& state) noexcept
+{
+    state += 0x9E3779B97F4A7C15ull;
+    auto z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// uniform in [-1, 1) from the upper 23 bits, a float in [1, 2) by its mantissa
+[[nodiscard]] inline float bitsToBipolar(const uint32_t bits) noexcept
+{
+    return std::bit_cast<float>((bits >> 9) | 0x3F800000u) * 2.f - 3.f;
+}
+
+/*
+ * Lanes independent xoshiro128+ generators (Blackman, Vigna) side by side, the state as structure of arrays. A step
+ * is shifts, xors and an add on all lanes: vectorizes with plain SSE2, no multiply. 16 bytes of state per lane
+ * (plus the values of the last step fillBipolar() hasn't handed out yet), 96 bytes for 4 lanes against the 5 KB of
+ * a std::mt19937.
+ * The low bits of xoshiro128+ are weak, the float conversion only uses the upper 23.
+ * Deterministic for a seed, the lanes are seeded from consecutive splitmix64 outputs. Stream n of a seed is that
+ * sequence 2^64 * n steps ahead in every lane: one stream per voice or thread, none runs into another.
+ */
+template <size_t Lanes>
+class RandomLanes
+{
+public:
+    static_assert(Lanes > 0, "at least one lane");
+    static constexpr uint64_t DEFAULT_SEED{0x5EED5EED5EED5EEDull};
+
+    explicit RandomLanes(const uint64_t seed = DEFAULT_SEED, const uint64_t stream = 0) noexcept
+    {
+        this->seed(seed, stream);
+    }
+
+    void seed(uint64_t seed) noexcept
+    {
+        for (size_t l = 0; l < Lanes; ++l)
+        {
+            const auto a = splitMix64(seed);
+            const auto b = splitMix64(seed);
+            m_state.s0[l] = static_cast<uint32_t>(a);
+            m_state.s1[l] = static_cast<uint32_t>(a >> 32);
+            m_state.s2[l] = static_cast<uint32_t>(b);
+            m_state.s3[l] = static_cast<uint32_t>(b >> 32) | 1u; // never all zero
+        }
+        m_pending = Lanes;
+    }
+
+    // stream jumps, not meant for the audio thread with large stream numbers
+    void seed(const uint64_t seed, const uint64_t stream) noexcept
+    {
+        this->seed(seed);
+        for (uint64_t n = 0; n < stream; ++n)
+        {
+            jump();
+        }
+    }
+
+    // advances every lane by 2^64 steps, drops the values fillBipolar() kept
+    void jump() noexcept
+    {
+        static constexpr std::array<uint32_t, 4> JUMP{0x8764000Bu, 0xF542D2D3u, 0x6FA035C3u, 0x77F2DB5Bu};
+        State sum;
+        std::array<uint32_t, Lanes> unused;
+        for (const auto word : JUMP)
+        {
+            for (uint32_t bit = 0; bit < 32; ++bit)
+            {
+                if (word & (1u << bit))
+                {
+                    sum.accumulate(m_state);
+                }
+                m_state.next(unused);
+            }
+        }
+        m_state = sum;
+        m_pending = Lanes;
+    }
+
+    // one value per lane, independent of the values fillBipolar() keeps for its next call
+    void next(std::array<uint32_t, Lanes>& out) noexcept
+    {
+        m_state.next(out);
+    }
+
+    // count uniform floats in [-1, 1), Lanes at a time. Values of the last step beyond count are kept for the next
+    // call, the sequence doesn't depend on how it is split into blocks.
+    void fillBipolar(float* out, const size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i < count && m_pending < Lanes; ++i)
+        {
+            out[i] = bitsToBipolar(m_bits[m_pending++]);
+        }
+        // local state, the compiler can not prove that out does not alias the members
+        auto state = m_state;
+        alignas(ALIGNMENT) std::array<uint32_t, Lanes> bits;
+        for (; i + Lanes <= count; i += Lanes)
+        {
+            state.next(bits);
+            for (size_t l = 0; l < Lanes; ++l)
+            {
+                out[i + l] = bitsToBipolar(bits[l]);
+            }
+        }
+        if (i < count)
+        {
+            state.next(m_bits);
+            const auto rest = count - i; // less than Lanes
+            for (m_pending = 0; m_pending < rest; ++m_pending)
+            {
+                out[i + m_pending] = bitsToBipolar(m_bits[m_pending]);
+            }
+        }
+        m_state = state;
+    }
+
+private:
+    // a vector register at most, no padding for few lanes
+    static constexpr size_t ALIGNMENT{std::min<size_t>(32, std::bit_ceil(Lanes) * sizeof(uint32_t))};
+
+    struct State
+    {
+        alignas(ALIGNMENT) std::array<uint32_t, Lanes> s0{};
+        alignas(ALIGNMENT) std::array<uint32_t, Lanes> s1{};
+        alignas(ALIGNMENT) std::array<uint32_t, Lanes> s2{};
+        alignas(ALIGNMENT) std::array<uint32_t, Lanes> s3{};
+
+        void accumulate(const State& other) noexcept
+        {
+            for (size_t l = 0; l < Lanes; ++l)
+            {
+                s0[l] ^= other.s0[l];
+                s1[l] ^= other.s1[l];
+                s2[l] ^= other.s2[l];
+                s3[l] ^= other.s3[l];
+            }
+        }
+
+        void next(std::array<uint32_t, Lanes>& out) noexcept
+        {
+            for (size_t l = 0; l < Lanes; ++l)
+            {
+                out[l] = s0[l] + s3[l];
+                const auto t = s1[l] << 9;
+                s2[l] ^= s0[l];
+                s3[l] ^= s1[l];
+                s1[l] ^= s2[l];
+                s0[l] ^= s3[l];
+                s2[l] ^= t;
+                s3[l] = std::rotl(s3[l], 11);
+            }
+        }
+    };
+
+    State m_state;
+    alignas(ALIGNMENT) std::array<uint32_t, Lanes> m_bits{}; // of the last step, from m_pending on not yet used
+    size_t m_pending{Lanes};
+};
+}
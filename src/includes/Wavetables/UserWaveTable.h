@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Wavetables/WaveTableStorage.h"
+
+namespace AbacDsp
+{
+// the band limited sets of the frames of an imported wavetable, immutable once published
+struct UserWaveTable
+{
+    std::vector<WaveTableSet> frames;
+    mutable std::atomic<uint32_t> users{0}; // oscillators holding it, see UserWaveTableSlot
+};
+
+/*
+ * Hands imported wavetables (see WaveTableImport.h) to running oscillators. The band limited sets are built off the
+ * audio thread and published with an atomic pointer exchange, oscillators pick the new table up with their next
+ * block. The audio thread only increments and decrements counters (adopt(), release()), it never blocks and never
+ * frees: a replaced table is retired and deleted by a later publish() or collect() on another thread, once no
+ * oscillator holds it and no adopt() that might have loaded it is in flight.
+ * The slot has to outlive the oscillators using it.
+ */
+class UserWaveTableSlot
+{
+  public:
+    UserWaveTableSlot() = default;
+    UserWaveTableSlot(const UserWaveTableSlot&) = delete;
+    UserWaveTableSlot& operator=(const UserWaveTableSlot&) = delete;
+
+    ~UserWaveTableSlot()
+    {
+        delete m_current.load();
+    }
+
+    void publish(std::unique_ptr<UserWaveTable> table)
+    {
+        std::scoped_lock lock(m_mutex);
+        if (const auto* replaced = m_current.exchange(table.release()))
+        {
+            m_retired.emplace_back(replaced);
+        }
+        m_version.fetch_add(1);
+        collectRetired();
+    }
+
+    // deletes the retired tables that are not used any more, call it now and then, not from the audio thread
+    void collect()
+    {
+        std::scoped_lock lock(m_mutex);
+        collectRetired();
+    }
+
+    [[nodiscard]] size_t numRetired() const
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_retired.size();
+    }
+
+    // changes with every publish()
+    [[nodiscard]] uint64_t version() const noexcept
+    {
+        return m_version.load();
+    }
+
+    // the current table (nullptr before the first publish), held until release()
+    [[nodiscard]] const UserWaveTable* adopt() const noexcept
+    {
+        // all sequentially consistent: an adopt() that starts after collectRetired() saw none in flight loads the
+        // table that replaced the retired ones
+        m_adopting.fetch_add(1);
+        const auto* table = m_current.load();
+        if (table)
+        {
+            table->users.fetch_add(1);
+        }
+        m_adopting.fetch_sub(1);
+        return table;
+    }
+
+    static void release(const UserWaveTable* table) noexcept
+    {
+        if (table)
+        {
+            table->users.fetch_sub(1);
+        }
+    }
+
+  private:
+    void collectRetired()
+    {
+        // with no adopt() in flight every holder of a retired table has counted itself
+        if (m_adopting.load() != 0)
+        {
+            return;
+        }
+        std::erase_if(m_retired, [](const auto& table) { return table->users.load() == 0; });
+    }
+
+    std::atomic<const UserWaveTable*> m_current{nullptr};
+    std::atomic<uint64_t> m_version{0};
+    mutable std::atomic<uint32_t> m_adopting{0};
+    mutable std::mutex m_mutex; // publishers and collectors, never the audio thread
+    std::vector<std::unique_ptr<const UserWaveTable>> m_retired;
+};
+
+// an oscillator's hold on the table of a slot, a copy holds it as well
+class UserWaveTableRef
+{
+  public:
+    UserWaveTableRef() = default;
+
+    explicit UserWaveTableRef(const UserWaveTableSlot& slot) noexcept
+        : m_slot(&slot)
+    {
+        update();
+    }
+
+    UserWaveTableRef(const UserWaveTableRef& other) noexcept
+        : m_slot(other.m_slot)
+        , m_table(other.m_table)
+        , m_version(other.m_version)
+    {
+        if (m_table)
+        {
+            m_table->users.fetch_add(1); // held by other, can't be deleted meanwhile
+        }
+    }
+
+    UserWaveTableRef(UserWaveTableRef&& other) noexcept
+        : m_slot(std::exchange(other.m_slot, nullptr))
+        , m_table(std::exchange(other.m_table, nullptr))
+        , m_version(other.m_version)
+    {
+    }
+
+    UserWaveTableRef& operator=(UserWaveTableRef other) noexcept
+    {
+        std::swap(m_slot, other.m_slot);
+        std::swap(m_table, other.m_table);
+        std::swap(m_version, other.m_version);
+        return *this;
+    }
+
+    ~UserWaveTableRef()
+    {
+        UserWaveTableSlot::release(m_table);
+    }
+
+    [[nodiscard]] bool isAttached() const noexcept
+    {
+        return m_slot != nullptr;
+    }
+
+    [[nodiscard]] bool isOutdated() const noexcept
+    {
+        return m_slot && m_slot->version() != m_version;
+    }
+
+    // adopts the table published last, lets go of the one before
+    void update() noexcept
+    {
+        m_version = m_slot->version(); // before adopt(), a publish in between is picked up by the next update
+        const auto* table = m_slot->adopt();
+        UserWaveTableSlot::release(m_table);
+        m_table = table;
+    }
+
+    // nullptr while the slot has no table
+    [[nodiscard]] const WaveTableSet* frame(const size_t index) const noexcept
+    {
+        if (!m_table || m_table->frames.empty())
+        {
+            return nullptr;
+        }
+        return &m_table->frames[std::min(index, m_table->frames.size() - 1)];
+    }
+
+  private:
+    const UserWaveTableSlot* m_slot{nullptr};
+    const UserWaveTable* m_table{nullptr};
+    uint64_t m_version{0};
+};
+}
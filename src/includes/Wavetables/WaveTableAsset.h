@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Wavetables/WaveTableStorage.h"
+
+namespace AbacDsp
+{
+/*
+ * The band limited tables of all BasicWaves baked into one file (the WaveTableBaker build target writes it):
+ * the header, then the WaveTables of every wave in BasicWave order, exactly as they are in memory (native byte
+ * order). Loading maps the file and points the sets at it, nothing is parsed or copied.
+ */
+struct WaveTableAssetHeader
+{
+    static constexpr std::array<char, 4> MAGIC{'A', 'W', 'T', 'B'};
+    // bump with every change of the table generation, older assets are rejected and the tables generated
+    static constexpr uint32_t VERSION{1};
+    static constexpr size_t NUM_WAVES{static_cast<size_t>(BasicWave::Last)};
+
+    std::array<char, 4> magic{MAGIC};
+    uint32_t version{VERSION};
+    uint32_t tableSize{WaveTableSize};
+    uint32_t waveTableBytes{sizeof(WaveTable)};
+    std::array<uint32_t, NUM_WAVES> numTables{};
+};
+
+static_assert(sizeof(WaveTableAssetHeader) % alignof(WaveTable) == 0, "tables follow the header unpadded");
+
+// read only view of a whole file, mapped where the platform allows it
+class MappedFile
+{
+  public:
+    explicit MappedFile(const std::string& path)
+    {
+#if defined(_WIN32)
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            return;
+        }
+        m_buffer.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (file.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size())))
+        {
+            m_data = m_buffer.data();
+            m_size = m_buffer.size();
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return;
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            void* mapped = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED)
+            {
+                m_data = static_cast<const std::byte*>(mapped);
+                m_size = static_cast<size_t>(info.st_size);
+            }
+        }
+        ::close(fd); // the mapping stays valid
+#endif
+    }
+
+    ~MappedFile()
+    {
+#if !defined(_WIN32)
+        if (m_data)
+        {
+            ::munmap(const_cast<std::byte*>(m_data), m_size);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept
+    {
+        return {m_data, m_size};
+    }
+
+  private:
+    const std::byte* m_data{nullptr};
+    size_t m_size{0};
+#if defined(_WIN32)
+    std::vector<std::byte> m_buffer;
+#endif
+};
+
+class WaveTableAsset
+{
+  public:
+    // check isValid(), a missing, truncated or foreign file (other version, table size or layout) is not
+    explicit WaveTableAsset(const std::string& path)
+        : m_file(path)
+    {
+        const auto bytes = m_file.bytes();
+        if (bytes.size() < sizeof(WaveTableAssetHeader))
+        {
+            return;
+        }
+        WaveTableAssetHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        const WaveTableAssetHeader expected;
+        if (header.magic != expected.magic || header.version != expected.version ||
+            header.tableSize != expected.tableSize || header.waveTableBytes != expected.waveTableBytes)
+        {
+            return;
+        }
+        const auto* tables = reinterpret_cast<const WaveTable*>(bytes.data() + sizeof(header));
+        size_t offset = 0;
+        for (size_t wave = 0; wave < WaveTableAssetHeader::NUM_WAVES; ++wave)
+        {
+            if (header.numTables[wave] == 0)
+            {
+                return;
+            }
+            m_tables[wave] = {tables + offset, header.numTables[wave]};
+            offset += header.numTables[wave];
+        }
+        m_valid = bytes.size() == sizeof(header) + offset * sizeof(WaveTable);
+    }
+
+    [[nodiscard]] bool isValid() const noexcept
+    {
+        return m_valid;
+    }
+
+    // points into the mapped file, valid as long as the asset lives
+    [[nodiscard]] std::span<const WaveTable> tables(const BasicWave wave) const noexcept
+    {
+        return m_tables[static_cast<size_t>(wave)];
+    }
+
+    // the sets in BasicWave order
+    static bool write(const std::string& path,
+                      const std::array<std::span<const WaveTable>, WaveTableAssetHeader::NUM_WAVES>& sets)
+    {
+        WaveTableAssetHeader header;
+        for (size_t wave = 0; wave < sets.size(); ++wave)
+        {
+            header.numTables[wave] = static_cast<uint32_t>(sets[wave].size());
+        }
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& tables : sets)
+        {
+            file.write(reinterpret_cast<const char*>(tables.data()),
+                       static_cast<std::streamsize>(tables.size_bytes()));
+        }
+        return static_cast<bool>(file.flush());
+    }
+
+  private:
+    MappedFile m_file;
+    std::array<std::span<const WaveTable>, WaveTableAssetHeader::NUM_WAVES> m_tables{};
+    bool m_valid{false};
+};
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <numbers>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AudioFile.h"
+#include "Wavetables/UserWaveTable.h"
+#include "Wavetables/WaveTableStorage.h"
+
+namespace AbacDsp
+{
+/*
+ * One cycle of any length as a cycle of WaveTableSize samples, resampled in the frequency domain: the DFT at the length
+ * of the cycle, the harmonics below WaveTableSize / 2 summed up again. Harmonics above can't fold back into the table
+ * as they would when interpolating a longer cycle (bandLimit() couldn't remove them afterwards).
+ */
+inline std::vector<float> resampleCycle(const std::vector<float>& samples)
+{
+    const auto length = samples.size();
+    // the Nyquist bin of an even length is ambiguous, it is left out like the one of the table
+    const auto numHarmonics = std::min((length - 1) / 2, WaveTableSize / 2 - 1);
+    std::vector<double> sourceCos(length);
+    std::vector<double> sourceSin(length);
+    for (size_t n = 0; n < length; ++n)
+    {
+        const auto w = 2 * std::numbers::pi * static_cast<double>(n) / static_cast<double>(length);
+        sourceCos[n] = std::cos(w);
+        sourceSin[n] = std::sin(w);
+    }
+    std::vector<double> tableCos(WaveTableSize);
+    std::vector<double> tableSin(WaveTableSize);
+    for (size_t n = 0; n < WaveTableSize; ++n)
+    {
+        const auto w = 2 * std::numbers::pi * static_cast<double>(n) / WaveTableSize;
+        tableCos[n] = std::cos(w);
+        tableSin[n] = std::sin(w);
+    }
+    const auto dc = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(length);
+    std::vector<double> cycle(WaveTableSize, dc);
+    for (size_t k = 1; k <= numHarmonics; ++k)
+    {
+        double re = 0;
+        double im = 0;
+        for (size_t n = 0, phase = 0; n < length; ++n, phase = (phase + k) % length)
+        {
+            re += samples[n] * sourceCos[phase];
+            im -= samples[n] * sourceSin[phase];
+        }
+        re *= 2. / static_cast<double>(length);
+        im *= 2. / static_cast<double>(length);
+        for (size_t n = 0, phase = 0; n < WaveTableSize; ++n, phase = (phase + k) % WaveTableSize)
+        {
+            cycle[n] += re * tableCos[phase] - im * tableSin[phase];
+        }
+    }
+    return {cycle.begin(), cycle.end()};
+}
+
+/*
+ * Single cycles of WaveTableSize samples from a WAV file (its first channel). A file of a multiple of WaveTableSize
+ * samples has that many frames (the common wavetable format), any other length is one cycle, resampled to
+ * WaveTableSize (resampleCycle()). Empty if the file can't be read.
+ */
+inline std::vector<std::vector<float>> readWaveTableFrames(const std::string& path)
+{
+    AudioFile<float> file;
+    if (!file.load(path) || file.getNumChannels() == 0 || file.getNumSamplesPerChannel() < 2)
+    {
+        return {};
+    }
+    const auto& samples = file.samples[0];
+    std::vector<std::vector<float>> frames;
+    if (samples.size() % WaveTableSize == 0)
+    {
+        for (auto it = samples.begin(); it != samples.end(); it += WaveTableSize)
+        {
+            frames.emplace_back(it, it + WaveTableSize);
+        }
+        return frames;
+    }
+    frames.push_back(resampleCycle(samples));
+    return frames;
+}
+
+inline std::unique_ptr<UserWaveTable> makeUserWaveTable(const std::vector<std::vector<float>>& frames)
+{
+    auto table = std::make_unique<UserWaveTable>();
+    table->frames.reserve(frames.size());
+    for (const auto& frame : frames)
+    {
+        table->frames.push_back(WaveTableStore::bandLimit(frame));
+    }
+    return table;
+}
+
+// builds on the calling thread, false if the file can't be read (the slot keeps its table then)
+inline bool importWaveTable(UserWaveTableSlot& slot, const std::string& path)
+{
+    const auto frames = readWaveTableFrames(path);
+    if (frames.empty())
+    {
+        return false;
+    }
+    slot.publish(makeUserWaveTable(frames));
+    return true;
+}
+
+// imports on a background thread, one file after the other, for the message thread
+class WaveTableImporter
+{
+  public:
+    WaveTableImporter() = default;
+    WaveTableImporter(const WaveTableImporter&) = delete;
+    WaveTableImporter& operator=(const WaveTableImporter&) = delete;
+
+    ~WaveTableImporter()
+    {
+        wait();
+    }
+
+    // waits for an import still running before, the slot has to outlive the import
+    std::future<bool> importAsync(UserWaveTableSlot& slot, const std::string& path)
+    {
+        wait();
+        std::promise<bool> imported;
+        auto result = imported.get_future();
+        m_thread = std::thread([&slot, path, imported = std::move(imported)]() mutable
+                               { imported.set_value(importWaveTable(slot, path)); });
+        return result;
+    }
+
+    void wait()
+    {
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+  private:
+    std::thread m_thread;
+};
+}
@@ -1,13 +1,60 @@
 #pragma once
 
-#include "../../../test/Wavetables/WaveTableStorage.h"
-#include "DSP/SmoothingParameter.h"
+#include "Wavetables/UserWaveTable.h"
+#include "Wavetables/WaveTableStorage.h"
+#include "Numbers/Random.h"
+#include "Parameters/SmoothingParameter.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <vector>
 
 namespace AbacDsp
 {
 
+/*
+ * The two adjacent wavesets of three a morph value in [-1, 1] blends (subIndex and subIndex + 1, weighted 1 - morph
+ * and morph) and the share of white noise in the blend.
+ */
+struct WaveMorph
+{
+    size_t subIndex{0};
+    float morph{0.f};
+    bool hasNoise{false};
+    float noiseRatio{0.f};
+
+    static WaveMorph of(const float value, const std::array<const WaveTableSet*, 3>& set) noexcept
+    {
+        WaveMorph result;
+        const auto morph = std::clamp((value + 1) * 0.5f, 0.f, 1.f) * (set.size() - 1);
+        result.subIndex = std::floor(morph);
+        result.morph = morph - result.subIndex;
+        if (result.subIndex >= set.size() - 1)
+        {
+            result.subIndex = set.size() - 2;
+            result.morph = 0.999999f;
+        }
+        // if any of the active tables is a noise wave table
+        const bool isWhite0 = set[result.subIndex]->wave == BasicWave::White;
+        const bool isWhite1 = set[result.subIndex + 1]->wave == BasicWave::White;
+        result.hasNoise = isWhite0 || isWhite1;
+        if (isWhite0 && isWhite1)
+        {
+            result.noiseRatio = 1.f;
+        }
+        else if (isWhite0)
+        {
+            result.noiseRatio = std::abs(1 - result.morph);
+        }
+        else if (isWhite1)
+        {
+            result.noiseRatio = std::abs(result.morph);
+        }
+        return result;
+    }
+};
+
 /*
  * This wave table oscillator contains following options:
  * - 3 wavetables between we can morph, potentially it could be extended to a classic
@@ -18,6 +65,10 @@ namespace AbacDsp
  * - we have a pwm mode which can also be used (subtract wave from itself with a phase offset)
  * - morphmode has no smoothing (seems to be resilient to it)
  * - pwm needs smoothing, changes are quite drastic
+ * - the white noise is reproducible: give every voice its own noise stream of the seed
+ * - setWaveset() waits for a set that isn't built yet, requestWaveset() plays a sine until it is
+ * - setUserWaveset() plays a frame of an imported wavetable, a table published later is swapped in by the next
+ *   processBlock()
  */
 class WaveTableOscillator
 {
@@ -28,20 +79,43 @@ class WaveTableOscillator
         Soft,
         Strong
     };
-    explicit WaveTableOscillator(const float sampleRate)
+    using NoiseRandom = RandomLanes<4>;
+
+    explicit WaveTableOscillator(const float sampleRate, const uint64_t noiseSeed = NoiseRandom::DEFAULT_SEED,
+                                 const uint64_t noiseStream = 0)
         : m_sampleRate(sampleRate)
+        , m_set{&WaveTableStore::getTableSet(BasicWave::Sine), &WaveTableStore::getTableSet(BasicWave::Square),
+                &WaveTableStore::getTableSet(BasicWave::Saw)}
+        , m_noise(noiseSeed, noiseStream)
     {
-        setWaveset(0, BasicWave::Sine);
-        setWaveset(1, BasicWave::Square);
-        setWaveset(2, BasicWave::Saw);
+        applyMorph();
     }
 
+    // points to the shared tables of the store, no copy and no allocation
     void setWaveset(const size_t targetIndex, const BasicWave waveIndex)
     {
-        m_set[targetIndex] = WaveTableStore::getTableSet(waveIndex);
+        m_waves[targetIndex] = waveIndex;
+        m_user[targetIndex] = {};
+        m_set[targetIndex] = &WaveTableStore::getTableSet(waveIndex);
         applyMorph();
     }
 
+    // never blocks (audio thread): a set still being built is swapped in by a later processBlock()
+    void requestWaveset(const size_t targetIndex, const BasicWave waveIndex) noexcept
+    {
+        m_waves[targetIndex] = waveIndex;
+        m_user[targetIndex] = {};
+        refreshSets();
+    }
+
+    // never blocks and never frees (audio thread), plays a sine while the slot has no table
+    void setUserWaveset(const size_t targetIndex, const UserWaveTableSlot& slot, const size_t frame = 0) noexcept
+    {
+        m_user[targetIndex] = UserWaveTableRef{slot};
+        m_userFrame[targetIndex] = frame;
+        refreshSets();
+    }
+
     // don't change table when doing slight changes to pitch
     void changeFrequency(const float frequency) noexcept
     {
@@ -67,6 +141,11 @@ class WaveTableOscillator
         updateWaveTableIndices();
     }
 
+    void seedNoise(const uint64_t seed, const uint64_t stream = 0) noexcept
+    {
+        m_noise.seed(seed, stream);
+    }
+
     void setPwmMode(const PwmMode mode)
     {
         m_pwmMode = mode;
@@ -93,6 +172,10 @@ class WaveTableOscillator
     // samples we can process without wrapping
     void processBlock(float* target, const size_t numSamples)
     {
+        if (m_pendingSets || hasNewUserTable())
+        {
+            refreshSets();
+        }
         if (!m_pwm.hasStoppedSmoothing())
         {
             if (const auto pwm = m_pwm.getValue(); m_pwmMode != PwmMode::Off)
@@ -171,53 +254,51 @@ class WaveTableOscillator
     {
         // keep save against aliasing if we pitch up (we loose very high frequencies only>12k)
         // factor 2 seems to be a good guess (hearing estimated)
-        m_curTableIdx[0] = m_set[m_tblSubIdx].getIndexByFrequency(m_phaseInc * 2);
-        m_curTableIdx[1] = m_set[m_tblSubIdx + 1].getIndexByFrequency(m_phaseInc * 2);
+        m_curTableIdx[0] = m_set[m_tblSubIdx]->getIndexByFrequency(m_phaseInc * 2);
+        m_curTableIdx[1] = m_set[m_tblSubIdx + 1]->getIndexByFrequency(m_phaseInc * 2);
     }
 
-    void applyMorph()
+    [[nodiscard]] bool hasNewUserTable() const noexcept
     {
-        const auto morph = std::clamp((m_morphValue + 1) * 0.5f, 0.f, 1.f) * (m_set.size() - 1);
-        m_tblSubIdx = std::floor(morph);
-        m_morph = morph - m_tblSubIdx;
-        if (m_tblSubIdx >= m_set.size() - 1)
-        {
-            m_tblSubIdx = m_set.size() - 2;
-            m_morph = 0.999999f;
-        }
-        handleNoise();
+        return std::ranges::any_of(m_user, [](const auto& user) { return user.isOutdated(); });
     }
 
-    void handleNoise()
+    void refreshSets() noexcept
     {
-        // if any of the active tables is a noise wave table
-        const bool isWhite0 = m_set[m_tblSubIdx].wave == BasicWave::White;
-        const bool isWhite1 = m_set[m_tblSubIdx + 1].wave == BasicWave::White;
-
-        m_hasNoise = isWhite0 || isWhite1;
-
-        if (isWhite0 && isWhite1)
-        {
-            m_noiseRatio = 1.f;
-        }
-        else if (isWhite0)
-        {
-            m_noiseRatio = std::abs(1 - m_morph);
-        }
-        else if (isWhite1)
+        bool ready = true;
+        for (size_t i = 0; i < m_set.size(); ++i)
         {
-            m_noiseRatio = std::abs(m_morph);
-        }
-        else
-        {
-            m_noiseRatio = 0.f;
+            if (m_user[i].isAttached())
+            {
+                if (m_user[i].isOutdated())
+                {
+                    m_user[i].update();
+                }
+                const auto* frame = m_user[i].frame(m_userFrame[i]);
+                m_set[i] = frame ? frame : &WaveTableStore::tryGetTableSet(BasicWave::Sine).set;
+                continue;
+            }
+            const auto lookup = WaveTableStore::tryGetTableSet(m_waves[i]);
+            m_set[i] = &lookup.set;
+            ready = ready && lookup.ready;
         }
+        m_pendingSets = !ready;
+        applyMorph(); // the table indices fit any set, the stand in as well
+    }
+
+    void applyMorph()
+    {
+        const auto morph = WaveMorph::of(m_morphValue, m_set);
+        m_tblSubIdx = morph.subIndex;
+        m_morph = morph.morph;
+        m_hasNoise = morph.hasNoise;
+        m_noiseRatio = morph.noiseRatio;
     }
 
     [[nodiscard]] float getOutput() const noexcept
     {
-        const auto& wt1 = m_set[m_tblSubIdx].tables[m_curTableIdx[0]];
-        const auto& wt2 = m_set[m_tblSubIdx + 1].tables[m_curTableIdx[1]];
+        const auto& wt1 = m_set[m_tblSubIdx]->tables[m_curTableIdx[0]];
+        const auto& wt2 = m_set[m_tblSubIdx + 1]->tables[m_curTableIdx[1]];
         const float pos = m_phasor * TableSize;
         const auto idx = static_cast<size_t>(pos);
         const float frac = pos - idx;
@@ -228,8 +309,8 @@ class WaveTableOscillator
 
     [[nodiscard]] float getOutputOffset() const noexcept
     {
-        const auto& wt1 = m_set[m_tblSubIdx].tables[m_curTableIdx[0]];
-        const auto& wt2 = m_set[m_tblSubIdx + 1].tables[m_curTableIdx[1]];
+        const auto& wt1 = m_set[m_tblSubIdx]->tables[m_curTableIdx[0]];
+        const auto& wt2 = m_set[m_tblSubIdx + 1]->tables[m_curTableIdx[1]];
         const float pos = m_phasorWithOffset * TableSize;
         const auto idx = static_cast<size_t>(pos);
         const float frac = pos - idx;
@@ -261,14 +342,21 @@ class WaveTableOscillator
         }
     }
 
+    // uniform in [-2, 2) scaled by noiseRatio, drawn a chunk at a time
     void addNoiseBlock(float* target, const size_t numSamples, const float noiseRatio)
     {
-        std::transform(target, target + numSamples, target,
-                       [this, noiseRatio](const float in)
-                       {
-                           const float v = m_dist(m_rng) * noiseRatio;
-                           return in + v;
-                       });
+        constexpr size_t chunkSize{64};
+        std::array<float, chunkSize> noise;
+        const auto gain = 2.f * noiseRatio;
+        for (size_t offset = 0; offset < numSamples; offset += chunkSize)
+        {
+            const auto count = std::min(chunkSize, numSamples - offset);
+            m_noise.fillBipolar(noise.data(), count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                target[offset + i] += gain * noise[i];
+            }
+        }
     }
 
     void subtractPwmBlock(float* target, const size_t numSamples, const float factor)
@@ -330,7 +418,11 @@ class WaveTableOscillator
 
     size_t m_tblSubIdx{0};                     // Index into WaveTableCollection
     std::array<size_t, 2> m_curTableIdx{0, 0}; // Index within WaveTableSet
-    std::array<WaveTableSet, 3> m_set{};
+    std::array<const WaveTableSet*, 3> m_set{}; // immutable, owned by WaveTableStore
+    std::array<BasicWave, 3> m_waves{BasicWave::Sine, BasicWave::Square, BasicWave::Saw};
+    bool m_pendingSets{false}; // a requested set is not published yet
+    std::array<UserWaveTableRef, 3> m_user{}; // attached for imported wavetables
+    std::array<size_t, 3> m_userFrame{};
     bool m_hasNoise{false};
     float m_noiseRatio{0.f};
     PwmMode m_pwmMode{PwmMode::Off};
@@ -338,7 +430,6 @@ class WaveTableOscillator
 
     float m_morph{0.f};
 
-    std::mt19937 m_rng{std::random_device{}()};
-    std::uniform_real_distribution<float> m_dist{-2.0f, 2.0f};
+    NoiseRandom m_noise;
 };
 }
\ No newline at end of file
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "Numbers/Random.h"
+#include "Wavetables/WaveTableOscillator.h"
+#include "Wavetables/WaveTableStorage.h"
+
+namespace AbacDsp
+{
+/*
+ * Voices independent WaveTableOscillator (one per voice of a polysynth) with phasors, increments, morph and noise
+ * share kept as structure of arrays, every frame advances all voices in SIMD lanes. Each voice has its own three
+ * wavesets, frequency and morph, like a WaveTableOscillator without pwm.
+ * A frame is three lane loops: phase to table index and fraction, the table reads of all voices (a gather, the
+ * voices read from different tables) and the interpolation, morph blend and wrap. The wrap is per voice and
+ * branch free, no samplesUntilWrap split.
+ * The native layout is interleaved (frame by frame), planar voice buffers are transposed in small chunks.
+ * setWaveset() waits for a set that isn't built yet, requestWaveset() plays a sine until it is.
+ */
+template <size_t Voices>
+class WaveTableOscillatorBank
+{
+public:
+    static_assert(Voices > 0, "WaveTableOscillatorBank needs at least one voice");
+    using NoiseRandom = RandomLanes<8>;
+
+    explicit WaveTableOscillatorBank(const float sampleRate, const uint64_t noiseSeed = NoiseRandom::DEFAULT_SEED)
+        : m_sampleRate(sampleRate)
+        , m_noise(noiseSeed)
+    {
+        m_set.fill({&WaveTableStore::getTableSet(BasicWave::Sine), &WaveTableStore::getTableSet(BasicWave::Square),
+                    &WaveTableStore::getTableSet(BasicWave::Saw)});
+        m_waves.fill({BasicWave::Sine, BasicWave::Square, BasicWave::Saw});
+        for (size_t voice = 0; voice < Voices; ++voice)
+        {
+            applyMorph(voice);
+        }
+    }
+
+    // points to the shared tables of the store, no allocation
+    void setWaveset(const size_t voice, const size_t targetIndex, const BasicWave wave)
+    {
+        m_waves[voice][targetIndex] = wave;
+        m_set[voice][targetIndex] = &WaveTableStore::getTableSet(wave);
+        applyMorph(voice);
+    }
+
+    // never blocks (audio thread): a set still being built is swapped in by a later processFrames()
+    void requestWaveset(const size_t voice, const size_t targetIndex, const BasicWave wave) noexcept
+    {
+        m_waves[voice][targetIndex] = wave;
+        refreshSets();
+    }
+
+    // picks the band limited tables for the frequency, e.g. on note on
+    void setFrequency(const size_t voice, const float frequency) noexcept
+    {
+        changeFrequency(voice, frequency);
+        updateTableIndices(voice);
+    }
+
+    // pitch changes keep the tables
+    void changeFrequency(const size_t voice, const float frequency) noexcept
+    {
+        m_phaseInc[voice] = frequency / m_sampleRate;
+    }
+
+    void setMorph(const size_t voice, const float value) noexcept
+    {
+        m_morphValue[voice] = value;
+        applyMorph(voice);
+    }
+
+    // restarts the phase, e.g. on note on
+    void reset(const size_t voice) noexcept
+    {
+        m_phasor[voice] = 0.f;
+    }
+
+    // interleaved frames: out[frame * Voices + voice]
+    void processFrames(float* out, const size_t numFrames) noexcept
+    {
+        if (m_pendingSets)
+        {
+            refreshSets();
+        }
+        // phases and table pointers copied once per block, every frame stored into out would reload them otherwise
+        const Lane phaseInc = m_phaseInc;
+        const Lane morph = m_morph;
+        const auto table0 = m_table0;
+        const auto table1 = m_table1;
+        Lane phasor = m_phasor;
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            alignas(Alignment) std::array<int32_t, Voices> index;
+            Lane fraction;
+            for (size_t l = 0; l < Voices; ++l)
+            {
+                const auto pos = phasor[l] * static_cast<float>(WaveTableSize);
+                index[l] = static_cast<int32_t>(pos);
+                fraction[l] = pos - static_cast<float>(index[l]);
+            }
+            Lane a0, a1, b0, b1;
+            for (size_t l = 0; l < Voices; ++l)
+            {
+                a0[l] = table0[l][index[l]];
+                a1[l] = table0[l][index[l] + 1];
+                b0[l] = table1[l][index[l]];
+                b1[l] = table1[l][index[l] + 1];
+            }
+            auto* y = out + i * Voices;
+            for (size_t l = 0; l < Voices; ++l)
+            {
+                const auto v1 = a0[l] + fraction[l] * (a1[l] - a0[l]);
+                const auto v2 = b0[l] + fraction[l] * (b1[l] - b0[l]);
+                y[l] = morph[l] * v2 + (1 - morph[l]) * v1;
+                phasor[l] += phaseInc[l];
+                phasor[l] -= phasor[l] >= 1.f ? 1.f : 0.f;
+            }
+        }
+        m_phasor = phasor;
+        if (m_hasNoise)
+        {
+            addNoise(out, numFrames);
+        }
+    }
+
+    // planar: one pointer per voice
+    void processBlock(float* const* out, const size_t numSamples) noexcept
+    {
+        std::array<float, ChunkSize * Voices> frames;
+        for (size_t offset = 0; offset < numSamples; offset += ChunkSize)
+        {
+            const auto count = std::min(ChunkSize, numSamples - offset);
+            processFrames(frames.data(), count);
+            for (size_t voice = 0; voice < Voices; ++voice)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    out[voice][offset + i] = frames[i * Voices + voice];
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr size_t ChunkSize{64};
+    static constexpr size_t Alignment{std::min<size_t>(std::bit_ceil(Voices * sizeof(float)), 64)};
+
+    struct alignas(Alignment) Lane : std::array<float, Voices>
+    {
+    };
+
+    void refreshSets() noexcept
+    {
+        bool ready = true;
+        for (size_t voice = 0; voice < Voices; ++voice)
+        {
+            for (size_t i = 0; i < m_set[voice].size(); ++i)
+            {
+                const auto lookup = WaveTableStore::tryGetTableSet(m_waves[voice][i]);
+                m_set[voice][i] = &lookup.set;
+                ready = ready && lookup.ready;
+            }
+            applyMorph(voice); // the table indices fit any set, the stand in as well
+        }
+        m_pendingSets = !ready;
+    }
+
+    void updateTableIndices(const size_t voice) noexcept
+    {
+        // keep save against aliasing if we pitch up, as WaveTableOscillator
+        m_tableIndex0[voice] = m_set[voice][m_subIndex[voice]]->getIndexByFrequency(m_phaseInc[voice] * 2);
+        m_tableIndex1[voice] = m_set[voice][m_subIndex[voice] + 1]->getIndexByFrequency(m_phaseInc[voice] * 2);
+        updateTables(voice);
+    }
+
+    void applyMorph(const size_t voice)
+    {
+        const auto morph = WaveMorph::of(m_morphValue[voice], m_set[voice]);
+        m_subIndex[voice] = morph.subIndex;
+        m_morph[voice] = morph.morph;
+        m_noiseGain[voice] = 2.f * morph.noiseRatio; // uniform in [-2, 2) as WaveTableOscillator
+        m_hasNoise = std::ranges::any_of(m_noiseGain, [](const float gain) { return gain != 0.f; });
+        updateTables(voice);
+    }
+
+    void updateTables(const size_t voice) noexcept
+    {
+        m_table0[voice] = m_set[voice][m_subIndex[voice]]->tables[m_tableIndex0[voice]].data.data();
+        m_table1[voice] = m_set[voice][m_subIndex[voice] + 1]->tables[m_tableIndex1[voice]].data.data();
+    }
+
+    // a chunk of frames at a time, scaled per voice
+    void addNoise(float* out, const size_t numFrames) noexcept
+    {
+        constexpr size_t chunkFrames{std::max<size_t>(1, 256 / Voices)};
+        std::array<float, chunkFrames * Voices> noise;
+        const Lane gain = m_noiseGain;
+        for (size_t offset = 0; offset < numFrames; offset += chunkFrames)
+        {
+            const auto count = std::min(chunkFrames, numFrames - offset);
+            m_noise.fillBipolar(noise.data(), count * Voices);
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto* y = out + (offset + i) * Voices;
+                for (size_t l = 0; l < Voices; ++l)
+                {
+                    y[l] += gain[l] * noise[i * Voices + l];
+                }
+            }
+        }
+    }
+
+    float m_sampleRate;
+    Lane m_phasor{};
+    Lane m_phaseInc{};
+    Lane m_morph{};
+    Lane m_noiseGain{};
+    std::array<const float*, Voices> m_table0{}; // samples of the active table of waveset m_subIndex
+    std::array<const float*, Voices> m_table1{}; // and of waveset m_subIndex + 1
+    bool m_hasNoise{false};
+
+    // control rate, per voice
+    std::array<std::array<const WaveTableSet*, 3>, Voices> m_set{};
+    std::array<std::array<BasicWave, 3>, Voices> m_waves{};
+    bool m_pendingSets{false}; // a requested set is not published yet
+    std::array<size_t, Voices> m_subIndex{};
+    std::array<size_t, Voices> m_tableIndex0{};
+    std::array<size_t, Voices> m_tableIndex1{};
+    std::array<float, Voices> m_morphValue{};
+    NoiseRandom m_noise;
+};
+}
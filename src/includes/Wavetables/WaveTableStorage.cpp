@@ -1,12 +1,121 @@
 
-#include "../../../test/Wavetables/WaveTableStorage.h"
+#include "Wavetables/WaveTableStorage.h"
+#include "Wavetables/WaveTableAsset.h"
 
+#include <memory>
+#include <thread>
 #include <utility>
 
 namespace AbacDsp
 {
 
-WaveTableSet WaveTableStore::fftFromSlice(const std::vector<float>& slice)
+namespace
+{
+std::unique_ptr<WaveTableAsset> s_asset; // mapped as long as the program runs, the sets point into it
+std::mutex s_assetMutex;
+
+// one wave bit per requested set, the top bit stops the worker. Requests before start() wait for it
+class WaveTableWorker
+{
+  public:
+    ~WaveTableWorker()
+    {
+        if (m_thread.joinable())
+        {
+            m_requests.fetch_or(STOP, std::memory_order_release);
+            m_requests.notify_one();
+            m_thread.join();
+        }
+    }
+
+    void start(void (*build)(size_t))
+    {
+        std::call_once(m_started, [this, build] { m_thread = std::thread([this, build] { run(build); }); });
+    }
+
+    // an atomic or and a wake up, no lock
+    void request(const size_t wave) noexcept
+    {
+        m_requests.fetch_or(1u << wave, std::memory_order_release);
+        m_requests.notify_one();
+    }
+
+  private:
+    void run(void (*build)(size_t))
+    {
+        while (true)
+        {
+            const auto pending = m_requests.exchange(0, std::memory_order_acquire);
+            if (pending & STOP)
+            {
+                return;
+            }
+            if (pending == 0)
+            {
+                m_requests.wait(0, std::memory_order_acquire);
+                continue;
+            }
+            for (size_t wave = 0; wave < 32; ++wave)
+            {
+                if (pending & (1u << wave))
+                {
+                    build(wave);
+                }
+            }
+        }
+    }
+
+    static constexpr uint32_t STOP{1u << 31};
+    std::atomic<uint32_t> m_requests{0};
+    std::once_flag m_started;
+    std::thread m_thread;
+};
+}
+
+bool WaveTableStore::useAsset(const std::string& path)
+{
+    startWorker(); // on startup, whether the asset is used or not
+    std::scoped_lock lock(s_assetMutex);
+    if (s_asset)
+    {
+        return false;
+    }
+    auto asset = std::make_unique<WaveTableAsset>(path);
+    if (!asset->isValid())
+    {
+        return false;
+    }
+    const auto numTables = harmonicLadder().size();
+    for (size_t wave = 0; wave < NUM_WAVES; ++wave)
+    {
+        // oscillators index the sets alike, every set needs the tables of the ladder
+        if (asset->tables(static_cast<BasicWave>(wave)).size() != numTables)
+        {
+            return false;
+        }
+    }
+    const auto& mapped = *(s_asset = std::move(asset));
+    for (size_t wave = 0; wave < NUM_WAVES; ++wave)
+    {
+        const auto basicWave = static_cast<BasicWave>(wave);
+        std::call_once(s_built[wave], [&] { publish(wave, {basicWave, mapped.tables(basicWave)}); });
+    }
+    return true;
+}
+
+bool WaveTableStore::writeAsset(const std::string& path)
+{
+    std::vector<WaveTableSet> sets;
+    sets.reserve(WaveTableAssetHeader::NUM_WAVES);
+    std::array<std::span<const WaveTable>, WaveTableAssetHeader::NUM_WAVES> tables;
+    for (size_t wave = 0; wave < tables.size(); ++wave)
+    {
+        tables[wave] = sets.emplace_back(prefill(static_cast<BasicWave>(wave))).tables;
+    }
+    return WaveTableAsset::write(path, tables);
+}
+
+std::vector<WaveTable> WaveTableStore::fftFromSlice(const std::vector<float>& slice)
 {
     std::vector freqWaveIm = slice;
     std::vector freqWaveRe(WaveTableSize, 0.f);
@@ -14,13 +123,8 @@ WaveTableSet WaveTableStore::fftFromSlice(const std::vector<float>& slice)
     return addSet(freqWaveRe, freqWaveIm);
 }
 
-WaveTableSet WaveTableStore::addSet(std::vector<float>& freqWaveRe, std::vector<float>& freqWaveIm)
+std::vector<WaveTable> WaveTableStore::addSet(std::vector<float>& freqWaveRe, std::vector<float>& freqWaveIm)
 {
-    // we create more fft filtered slices if narrowing the gap, this will decrease
-    // slight differences in the top harmonic content but raise the memory footprint
-    constexpr float minTop = 0.4f;
-    constexpr float maxTop = 0.6f;
-
     // Zero DC offset and Nyquist !!
     freqWaveRe[0] = 0.0f;
     freqWaveIm[0] = 0.0f;
@@ -31,12 +135,11 @@ WaveTableSet WaveTableStore::addSet(std::vector<float>& freqWaveRe, std::vector<
     const auto ai = freqWaveIm;
     float scale = 0.0f;
 
-    WaveTableSet newset;
+    std::vector<WaveTable> tables;
 
-    unsigned int maxHarmonic = WaveTableSize / 2;
-    while (maxHarmonic > 1)
+    for (const auto maxHarmonic : harmonicLadder())
     {
-        const float topFreq = maxTop / static_cast<float>(maxHarmonic);
+        const float topFreq = MAX_TOP / static_cast<float>(maxHarmonic);
         // we will not optimize the table for dominant harmonics,
         // otherwise morphing between tables becomes very complicate.
         // Instead, we assume the same topFrequency for every slice.
@@ -45,23 +148,53 @@ WaveTableSet WaveTableStore::addSet(std::vector<float>& freqWaveRe, std::vector<
         // Prepare harmonic data by setting everything over the topFreq to 0
         std::vector harmonicRe(WaveTableSize, 0.0f);
         std::vector harmonicIm(WaveTableSize, 0.0f);
-        for (int idx = 1; idx <= maxHarmonic; idx++)
+        for (unsigned int idx = 1; idx <= maxHarmonic; idx++)
         {
             harmonicRe[idx] = ar[idx];
             harmonicIm[idx] = ai[idx];
             harmonicRe[WaveTableSize - idx] = ar[WaveTableSize - idx];
             harmonicIm[WaveTableSize - idx] = ai[WaveTableSize - idx];
         }
-        scale = makeWaveTable(harmonicRe, harmonicIm, scale, topFreq, newset.tables);
-        // Prepare for next table
-        const auto newHarmonic = static_cast<int>(std::floor(minTop / topFreq + 0.5f));
+        scale = makeWaveTable(harmonicRe, harmonicIm, scale, topFreq, tables);
+    }
+    return tables;
+}
+
+std::vector<unsigned int> WaveTableStore::harmonicLadder()
+{
+    std::vector<unsigned int> ladder;
+    unsigned int maxHarmonic = WaveTableSize / 2;
+    while (maxHarmonic > 1)
+    {
+        ladder.push_back(maxHarmonic);
+        const float topFreq = MAX_TOP / static_cast<float>(maxHarmonic);
+        const auto newHarmonic = static_cast<unsigned int>(std::floor(MIN_TOP / topFreq + 0.5f));
         if (maxHarmonic == newHarmonic)
         {
             break;
         }
         maxHarmonic = newHarmonic;
     }
-    return newset;
+    return ladder;
+}
+
+std::vector<WaveTable> WaveTableStore::makeFallbackSine()
+{
+    // a single harmonic needs no band limiting, only the table count and topFreqs of a real set
+    std::vector<WaveTable> tables;
+    for (const auto maxHarmonic : harmonicLadder())
+    {
+        auto& table = tables.emplace_back();
+        table.topFreq = MAX_TOP / static_cast<float>(maxHarmonic);
+        for (size_t n = 0; n < WaveTableSize; ++n)
+        {
+            // the level of the compensated sine set
+            table.data[n] = 0.5f * std::numbers::sqrt2_v<float> *
+                std::sin(2.0f * std::numbers::pi_v<float> * static_cast<float>(n) / WaveTableSize);
+        }
+        table.data[WaveTableSize] = table.data[0];
+    }
+    return tables;
 }
 
 float WaveTableStore::makeWaveTable(std::vector<float>& ar, std::vector<float>& ai, float scale, const float topFreq,
@@ -137,5 +270,40 @@ void WaveTableStore::smallFft(std::vector<float>& ar, std::vector<float>& ai)
     }
 }
 
-std::vector<WaveTableSet> WaveTableStore::s_wtbls;
+// constant initialized, ready for requests from other static initializers
+constinit std::array<WaveTableSet, WaveTableStore::NUM_WAVES> WaveTableStore::s_sets;
+constinit std::array<std::once_flag, WaveTableStore::NUM_WAVES> WaveTableStore::s_built;
+constinit std::array<std::atomic<bool>, WaveTableStore::NUM_WAVES> WaveTableStore::s_ready{};
+
+namespace
+{
+// built after the sets, so it is joined before they are destroyed
+WaveTableWorker& worker()
+{
+    static WaveTableWorker s_worker;
+    return s_worker;
+}
+}
+
+const WaveTableSet& WaveTableStore::fallbackSine()
+{
+    static const WaveTableSet s_fallbackSine{BasicWave::Sine, makeFallbackSine()};
+    return s_fallbackSine;
+}
+
+void WaveTableStore::startWorker()
+{
+    fallbackSine(); // here, not on the audio thread
+    worker().start(&WaveTableStore::build);
+}
+
+void WaveTableStore::request(const BasicWave index) noexcept
+{
+    static_assert(NUM_WAVES < 32, "a request bit per wave");
+    const auto wave = static_cast<size_t>(index);
+    if (!s_ready[wave].load(std::memory_order_acquire))
+    {
+        worker().request(wave);
+    }
+}
 }
\ No newline at end of file
@@ -2,13 +2,20 @@
 
 #include <array>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <mutex>
 #include <numbers>
 #include <numeric>
-#include <random>
+#include <span>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "Numbers/Random.h"
+
 namespace AbacDsp
 {
 
@@ -41,28 +48,129 @@ struct WaveTable
 };
 
 
+// move only, tables points into its own generated tables or into a mapped WaveTableAsset
 struct WaveTableSet
 {
-    BasicWave wave;
-    std::vector<WaveTable> tables;
+    WaveTableSet() = default;
+
+    WaveTableSet(const BasicWave basicWave, std::vector<WaveTable> generated)
+        : wave(basicWave)
+        , tables(generated)
+        , m_generated(std::move(generated)) // the moved vector keeps its buffer
+    {
+    }
+
+    WaveTableSet(const BasicWave basicWave, const std::span<const WaveTable> mapped)
+        : wave(basicWave)
+        , tables(mapped)
+    {
+    }
+
+    WaveTableSet(WaveTableSet&&) noexcept = default;
+    WaveTableSet& operator=(WaveTableSet&&) noexcept = default;
+    WaveTableSet(const WaveTableSet&) = delete;
+    WaveTableSet& operator=(const WaveTableSet&) = delete;
+
+    BasicWave wave{BasicWave::Sine}; // BasicWave::Last for imported tables
+    std::span<const WaveTable> tables;
 
     [[nodiscard]] size_t getIndexByFrequency(const float inc) const noexcept
     {
         const auto it = std::ranges::find_if(tables, [inc](const auto& wt) { return inc < wt.topFreq; });
         return it != tables.end() ? std::distance(tables.begin(), it) : tables.size() - 1;
     }
+
+  private:
+    std::vector<WaveTable> m_generated;
+};
+
+// a set and if it is the one asked for, see WaveTableStore::tryGetTableSet()
+struct WaveTableSetLookup
+{
+    const WaveTableSet& set;
+    bool ready;
 };
 
+/*
+ * The band limited sets of the BasicWaves, each built on first use (or mapped from an asset) and never changed
+ * afterwards, oscillators share them. A set is published with a release store of its ready flag, readers that saw
+ * it ready use it without locks.
+ */
 class WaveTableStore
 {
   public:
-    static WaveTableSet& getTableSet(const BasicWave index)
+    // blocks until the set is built, builds it on the calling thread if no one else does
+    static const WaveTableSet& getTableSet(const BasicWave index)
     {
-        prefillTablesOnce();
-        return s_wtbls[static_cast<size_t>(index)];
+        startWorker();
+        const auto wave = static_cast<size_t>(index);
+        if (!s_ready[wave].load(std::memory_order_acquire))
+        {
+            build(wave);
+        }
+        return s_sets[wave];
+    }
+
+    /*
+     * Never blocks, for the audio thread: the set if it is published, otherwise a plain sine (as many tables as
+     * any set, no allocation) with ready false while the set is built in the background. Ask again on the next block.
+     * Needs startWorker(), getTableSet() or useAsset() first: they build the sine, and without the worker running the
+     * requested sets are never built.
+     */
+    static WaveTableSetLookup tryGetTableSet(const BasicWave index) noexcept
+    {
+        const auto wave = static_cast<size_t>(index);
+        if (s_ready[wave].load(std::memory_order_acquire))
+        {
+            return {s_sets[wave], true};
+        }
+        request(index);
+        return {fallbackSine(), false};
+    }
+
+    /*
+     * Has the set built on the background thread, one wave after the other. Only sets a bit and wakes the thread,
+     * requests before startWorker() are built once it runs.
+     */
+    static void request(BasicWave index) noexcept;
+
+    /*
+     * Builds the stand-in sine of tryGetTableSet() and starts the background thread of request(), once.
+     * getTableSet() and useAsset() start it as well, so it's running once an oscillator exists, never started by the
+     * audio thread.
+     */
+    static void startWorker();
+
+    /*
+     * Maps the tables of a baked asset (see WaveTableAsset.h) instead of generating them, call it on startup before
+     * any oscillator exists. The sets built already stay. Returns false for a missing or foreign asset (the sets are
+     * generated on use then) or if an asset is in use already.
+     */
+    static bool useAsset(const std::string& path);
+
+    // generates the tables of all waves and bakes them into an asset for useAsset()
+    static bool writeAsset(const std::string& path);
+
+    // the band limited tables of a single cycle of WaveTableSize samples, at the level of the BasicWave sets
+    static WaveTableSet bandLimit(const std::vector<float>& cycle)
+    {
+        auto tables = fftFromSlice(cycle);
+        const float rmsCompensation = calculateRMS(tables[0].data);
+        for (auto& [_, data] : tables)
+        {
+            applyCompensation(data, rmsCompensation, 0.5f);
+        }
+        return {BasicWave::Last, std::move(tables)}; // not a BasicWave
     }
 
   private:
+    static constexpr uint64_t NOISE_TABLE_SEED{0x7AB1E5EEDull};
+    // we create more fft filtered slices if narrowing the gap, this will decrease
+    // slight differences in the top harmonic content but raise the memory footprint
+    static constexpr float MIN_TOP{0.4f};
+    static constexpr float MAX_TOP{0.6f};
+    static constexpr size_t NUM_WAVES{static_cast<size_t>(BasicWave::Last)};
+
     template <std::ranges::range Range>
     static float calculateRMS(const Range& wave)
     {
@@ -82,20 +190,16 @@ class WaveTableStore
         }
     }
 
-    static void prefillTablesOnce() noexcept
+    // once per wave, concurrent callers wait for the first one
+    static void build(const size_t wave)
     {
-        static std::once_flag flag;
-        std::call_once(flag,
-                       []
-                       {
-                           s_wtbls.clear();
-                           s_wtbls.reserve(static_cast<size_t>(BasicWave::Last));
-                           for (int wave = static_cast<int>(BasicWave::Sine); wave < static_cast<int>(BasicWave::Last);
-                                ++wave)
-                           {
-                               s_wtbls.push_back(prefill(static_cast<BasicWave>(wave)));
-                           }
-                       });
+        std::call_once(s_built[wave], [wave] { publish(wave, prefill(static_cast<BasicWave>(wave))); });
+    }
+
+    static void publish(const size_t wave, WaveTableSet&& set) noexcept
+    {
+        s_sets[wave] = std::move(set);
+        s_ready[wave].store(true, std::memory_order_release);
     }
 
     static WaveTableSet prefill(const BasicWave wave)
@@ -144,7 +248,8 @@ class WaveTableStore
                                       });
                 break;
             case BasicWave::Square:
-                std::ranges::generate(waveData, [n = 0]() mutable { return (n++ < tableSize / 2) ? 1.0f : -1.0f; });
+                std::ranges::generate(waveData,
+                                      [n = size_t{0}]() mutable { return (n++ < tableSize / 2) ? 1.0f : -1.0f; });
                 break;
             case BasicWave::Pulse:
                 std::ranges::generate(waveData, [n = 0]() mutable { return (n++ < 0.2f * tableSize) ? 1.0f : -1.0f; });
@@ -154,44 +259,34 @@ class WaveTableStore
                 break;
 
             case BasicWave::NoiseFloor:
-            case BasicWave::White: // we fake the white table
-            {
-                std::mt19937 gen{std::random_device{}()};
-                std::uniform_real_distribution<float> dist(-1.f, 1.f);
-                std::ranges::generate(waveData, [&dist, &gen]() mutable { return dist(gen); });
+            case BasicWave::White: // we fake the white table, the same table in every run
+                RandomLanes<8>{NOISE_TABLE_SEED, static_cast<uint64_t>(wave)}.fillBipolar(waveData.data(),
+                                                                                          tableSize);
                 break;
-            }
             default:
                 break;
         }
 
-        WaveTableSet set = fftFromSlice(waveData);
-        set.wave = wave;
-
         if (wave == BasicWave::NoiseFloor || wave == BasicWave::White)
         {
-            scaleSet(set, 1E-5f);
-        }
-        else
-        {
-            const float rmsCompensation = calculateRMS(set.tables[0].data);
-            for (auto& [_, data] : set.tables)
-            {
-                applyCompensation(data, rmsCompensation, 0.5f);
-            }
+            auto tables = fftFromSlice(waveData);
+            scaleSet(tables, 1E-5f);
+            return {wave, std::move(tables)};
         }
+        auto set = bandLimit(waveData);
+        set.wave = wave;
         return set;
     }
 
-    static void scaleSet(WaveTableSet& set, const float factor)
+    static void scaleSet(std::vector<WaveTable>& tables, const float factor)
     {
-        for (auto& v : set.tables)
+        for (auto& v : tables)
         {
             std::transform(v.data.begin(), v.data.end(), v.data.begin(),
                            [factor](const float in) { return factor * in; });
         }
     }
-    static WaveTableSet fftFromSlice(const std::vector<float>& slice);
+    static std::vector<WaveTable> fftFromSlice(const std::vector<float>& slice);
 
     /*
      * @brief Generates band-limited wavetables by progressively reducing harmonics for antialiasing.
@@ -204,9 +299,18 @@ class WaveTableStore
      *   3. Generates time-domain wavetable via makeWaveTable()
      *   4. Adjusts maxHarmonic for next band until no significant harmonics remain
      *
-     * Resulting wavetable set is stored in s_wtbls for later playback at appropriate frequencies.
+     * Resulting wavetable set is stored in s_sets for later playback at appropriate frequencies.
      */
-    static WaveTableSet addSet(std::vector<float>& freqWaveRe, std::vector<float>& freqWaveIm);
+    static std::vector<WaveTable> addSet(std::vector<float>& freqWaveRe, std::vector<float>& freqWaveIm);
+
+    // the highest harmonic of every table of a set, the same for all sets so that table indices fit any of them
+    static std::vector<unsigned int> harmonicLadder();
+
+    // the stand-in of tryGetTableSet(), a sine in every table of the ladder
+    static std::vector<WaveTable> makeFallbackSine();
+
+    // built on first use (startWorker()), a static in the function, so other static initializers can't see it unbuilt
+    static const WaveTableSet& fallbackSine();
 
     /**
      * @brief Convert spectral data to a normalized wavetable with wrap sample and add to currently generated
@@ -217,6 +321,8 @@ class WaveTableStore
 
     static void smallFft(std::vector<float>& ar, std::vector<float>& ai);
 
-    static std::vector<WaveTableSet> s_wtbls;
+    static std::array<WaveTableSet, NUM_WAVES> s_sets;
+    static std::array<std::once_flag, NUM_WAVES> s_built;
+    static std::array<std::atomic<bool>, NUM_WAVES> s_ready;
 };
 }
\ No newline at end of file
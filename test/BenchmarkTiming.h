@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+
+/*
+ * Timing of the disabled benchmarks, TEST(DISABLED_..., benchmark...). Run them with
+ * --gtest_also_run_disabled_tests on an optimized build.
+ */
+namespace Benchmark
+{
+// wall clock seconds of repetitions calls of process() or process(repetition)
+template <typename Process>
+double seconds(const size_t repetitions, Process&& process)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < repetitions; ++r)
+    {
+        if constexpr (std::invocable<Process&, size_t>)
+        {
+            process(r);
+        }
+        else
+        {
+            process();
+        }
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// items are whatever all repetitions together process: samples, samples times channels, designs...
+template <typename Process>
+double nsPerItem(const size_t items, const size_t repetitions, Process&& process)
+{
+    return seconds(repetitions, process) * 1E9 / static_cast<double>(items);
+}
+
+template <typename Process>
+double itemsPerSecond(const size_t items, const size_t repetitions, Process&& process)
+{
+    return static_cast<double>(items) / seconds(repetitions, process);
+}
+
+// seconds of audio per second of cpu times the voices, all repetitions together render audioSeconds
+template <typename Process>
+double voicesPerCore(const double audioSeconds, const size_t voices, const size_t repetitions, Process&& process)
+{
+    return audioSeconds / seconds(repetitions, process) * static_cast<double>(voices);
+}
+
+// "label: 1.23 ns/sample"
+inline void report(const std::string_view label, const double value, const std::string_view unit = "ns/sample")
+{
+    std::cout << label << ": " << value << ' ' << unit << '\n';
+}
+}
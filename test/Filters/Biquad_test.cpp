@@ -1,6 +1,7 @@
 
 #include "Filters/Biquad.h"
 
+#include "BenchmarkTiming.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -8,6 +9,7 @@
 #include <array>
 #include <cmath>
 #include <numbers>
+#include <string>
 
 static constexpr double maxDeltaDb =
     0.05; // N.B.: be hard on the quality of Biquads filters, acceptable would be even +-0.5 dB
@@ -724,6 +726,90 @@ TEST(DspBiquadFilterTest, chebyshevFilterType2HighpassStereo)
     }
 }
 
+template <typename Design>
+void testChebyshevParallelMatchesSeries(Design design, const size_t firstOrder, const size_t lastOrder)
+{
+    constexpr auto sampleRate{48000.0f};
+    for (const bool isLowPass : {true, false})
+    {
+        for (size_t order = firstOrder; order <= lastOrder; ++order)
+        {
+            AbacDsp::ChebyshevBiquad series;
+            AbacDsp::ChebyshevBiquad parallel;
+            AbacDsp::ChebyshevBiquad parallelStereo;
+            series.setSampleRate(sampleRate);
+            parallel.setSampleRate(sampleRate);
+            parallelStereo.setSampleRate(sampleRate);
+            parallel.setTopology(AbacDsp::BiquadTopology::Parallel);
+            parallelStereo.setTopology(AbacDsp::BiquadTopology::Parallel);
+            design(series, order, isLowPass);
+            design(parallel, order, isLowPass);
+            design(parallelStereo, order, isLowPass);
+            std::vector<float> wave(48000, 0);
+            std::vector<float> expected(48000, 0);
+            std::vector<float> left(48000, 0);
+            std::vector<float> right(48000, 0);
+            for (float hz = 125.f / 4.f; hz < 20000; hz *= 2)
+            {
+                renderWithSineWave(wave, sampleRate, hz);
+                series.processBlock(wave.data(), expected.data(), wave.size());
+                parallel.processBlock(wave.data(), left.data(), wave.size());
+                const auto dbOf = [](const std::vector<float>& v)
+                {
+                    const auto [minV, maxV] = std::minmax_element(v.begin() + v.size() / 2, v.end());
+                    return std::log10(std::max(std::abs(*minV), std::abs(*maxV))) * 20.0f;
+                };
+                const auto expectedDb = dbOf(expected);
+                // the parallel form sums large residues, its noise floor is at about -80 dB
+                if (expectedDb < -60)
+                {
+                    EXPECT_LT(dbOf(left), -60) << "@" << hz << " order: " << order << " lowpass: " << isLowPass;
+                }
+                else
+                {
+                    EXPECT_NEAR(dbOf(left), expectedDb, 0.1f)
+                        << "@" << hz << " order: " << order << " lowpass: " << isLowPass;
+                }
+                parallelStereo.processBlockStereo(wave.data(), wave.data(), left.data(), right.data(), wave.size());
+                EXPECT_EQ(left, right);
+            }
+        }
+    }
+}
+
+TEST(DspBiquadFilterTest, chebyshevFilterType1ParallelMatchesSeries)
+{
+    testChebyshevParallelMatchesSeries([](AbacDsp::ChebyshevBiquad& sut, const size_t order, const bool isLowPass)
+                                       { sut.computeType1(order, 1000, 6, isLowPass); },
+                                       1, AbacDsp::ChebyshevBiquad::MAX_ORDER);
+}
+
+TEST(DspBiquadFilterTest, chebyshevFilterType2ParallelMatchesSeries)
+{
+    testChebyshevParallelMatchesSeries([](AbacDsp::ChebyshevBiquad& sut, const size_t order, const bool isLowPass)
+                                       { sut.computeType2(order, 1000, 3, isLowPass); },
+                                       2, AbacDsp::ChebyshevBiquad::MAX_ORDER);
+}
+
+TEST(DspBiquadFilterTest, chebyshevTopologySwitchAfterDesign)
+{
+    AbacDsp::ChebyshevBiquad series;
+    AbacDsp::ChebyshevBiquad parallel;
+    series.computeType1(6, 1000, 3, true);
+    parallel.computeType1(6, 1000, 3, true);
+    parallel.setTopology(AbacDsp::BiquadTopology::Parallel);
+    std::vector<float> impulse(2000, 0.f);
+    impulse[0] = 1.f;
+    std::vector<float> expected(impulse.size());
+    std::vector<float> result(impulse.size());
+    series.processBlock(impulse.data(), expected.data(), impulse.size());
+    parallel.processBlock(impulse.data(), result.data(), impulse.size());
+    for (size_t i = 0; i < impulse.size(); ++i)
+    {
+        ASSERT_NEAR(result[i], expected[i], 1E-5f) << "at " << i;
+    }
+}
+
 /*
  * // fc=1000 ripple=3 high pass
 std::array<std::array<float,5>, 5> coefficients={{
@@ -843,4 +929,736 @@ TEST(DISABLED_DspBiquadFilterTest, coefficientTables)
     sut.printCoefficients();
     sut.computeType2(10, 1000, 3, false);
     sut.printCoefficients();
-}
\ No newline at end of file
+}
+template <AbacDsp::BiquadFilterType Type, size_t Lanes>
+void testBankMatchesSingleBiquads(const float gain)
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr size_t numSamples{1000};
+    AbacDsp::BiquadBank<Type, Lanes> sut;
+    std::array<AbacDsp::Biquad<Type>, Lanes> reference;
+    std::array<std::vector<float>, Lanes> input;
+    std::array<std::vector<float>, Lanes> expected;
+    std::array<std::vector<float>, Lanes> output;
+    for (size_t lane = 0; lane < Lanes; ++lane)
+    {
+        const auto cf = 100.f * static_cast<float>(lane + 1);
+        sut.computeCoefficients(lane, sampleRate, cf, StandardQValue, gain);
+        reference[lane].computeCoefficients(sampleRate, cf, StandardQValue, gain);
+        input[lane].resize(numSamples);
+        output[lane].resize(numSamples);
+        expected[lane].resize(numSamples);
+        renderWithSineWave(input[lane], sampleRate, 50.f + 300.f * static_cast<float>(lane));
+        reference[lane].processBlock(input[lane].data(), expected[lane].data(), numSamples);
+    }
+    std::array<const float*, Lanes> in;
+    std::array<float*, Lanes> out;
+    for (size_t lane = 0; lane < Lanes; ++lane)
+    {
+        in[lane] = input[lane].data();
+        out[lane] = output[lane].data();
+    }
+    sut.processBlock(in.data(), out.data(), numSamples);
+    for (size_t lane = 0; lane < Lanes; ++lane)
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            ASSERT_NEAR(output[lane][i], expected[lane][i], 1E-6f) << "lane " << lane << " sample " << i;
+        }
+    }
+}
+
+TEST(DspBiquadBankTest, matchesSingleBiquads)
+{
+    testBankMatchesSingleBiquads<AbacDsp::BiquadFilterType::LowPass, 4>(0.f);
+    testBankMatchesSingleBiquads<AbacDsp::BiquadFilterType::HighPass, 8>(0.f);
+    testBankMatchesSingleBiquads<AbacDsp::BiquadFilterType::BandPass, 16>(0.f);
+    testBankMatchesSingleBiquads<AbacDsp::BiquadFilterType::Notch, 8>(0.f);
+    testBankMatchesSingleBiquads<AbacDsp::BiquadFilterType::Peak, 8>(6.f);
+    testBankMatchesSingleBiquads<AbacDsp::BiquadFilterType::LoShelf, 8>(-6.f);
+    testBankMatchesSingleBiquads<AbacDsp::BiquadFilterType::HiShelf, 8>(6.f);
+    testBankMatchesSingleBiquads<AbacDsp::BiquadFilterType::AllPass, 4>(0.f);
+}
+
+TEST(DspBiquadBankTest, processAudioBufferInPlace)
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr size_t numFrames{512};
+    AudioBuffer<4, numFrames> buffer;
+    AbacDsp::BiquadBank<AbacDsp::BiquadFilterType::LowPass, 4> sut;
+    std::array<AbacDsp::Biquad<AbacDsp::BiquadFilterType::LowPass>, 4> reference;
+    std::array<std::vector<float>, 4> expected;
+    for (size_t ch = 0; ch < 4; ++ch)
+    {
+        sut.computeCoefficients(ch, sampleRate, 500.f * static_cast<float>(ch + 1), StandardQValue, 0.f);
+        reference[ch].computeCoefficients(sampleRate, 500.f * static_cast<float>(ch + 1), StandardQValue, 0.f);
+        expected[ch].resize(numFrames);
+        renderWithSineWave(expected[ch], sampleRate, 1000.f);
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            buffer(i, ch) = expected[ch][i];
+        }
+        reference[ch].processBlock(expected[ch].data(), expected[ch].data(), numFrames);
+    }
+    sut.processBlock(buffer);
+    for (size_t ch = 0; ch < 4; ++ch)
+    {
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            ASSERT_NEAR(buffer(i, ch), expected[ch][i], 1E-6f) << "channel " << ch << " frame " << i;
+        }
+    }
+}
+
+TEST(DISABLED_DspBiquadBankTest, benchmarkThroughputPerChannel)
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr size_t Channels{16};
+    constexpr size_t numSamples{4096};
+    constexpr size_t repetitions{200};
+    // out of place, so repeated runs don't decay into denormals
+    std::array<std::vector<float>, Channels> input;
+    std::array<std::vector<float>, Channels> output;
+    std::array<const float*, Channels> in;
+    std::array<float*, Channels> out;
+    std::vector<float> interleavedIn(Channels * numSamples);
+    std::vector<float> interleavedOut(Channels * numSamples);
+    for (size_t ch = 0; ch < Channels; ++ch)
+    {
+        input[ch].resize(numSamples);
+        output[ch].resize(numSamples);
+        renderWithSineWave(input[ch], sampleRate, 100.f * static_cast<float>(ch + 1));
+        in[ch] = input[ch].data();
+        out[ch] = output[ch].data();
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            interleavedIn[i * Channels + ch] = input[ch][i];
+        }
+    }
+    std::array<AbacDsp::Biquad<AbacDsp::BiquadFilterType::LowPass>, Channels> singles;
+    AbacDsp::BiquadBank<AbacDsp::BiquadFilterType::LowPass, Channels> bank;
+    for (size_t ch = 0; ch < Channels; ++ch)
+    {
+        singles[ch].computeCoefficients(sampleRate, 1000.f, StandardQValue, 0.f);
+    }
+    bank.computeCoefficients(sampleRate, 1000.f, StandardQValue, 0.f);
+
+    constexpr size_t items{repetitions * numSamples * Channels};
+    const auto singleNs = Benchmark::nsPerItem(items, repetitions,
+                                               [&]
+                                               {
+                                                   for (size_t ch = 0; ch < Channels; ++ch)
+                                                   {
+                                                       singles[ch].processBlock(in[ch], out[ch], numSamples);
+                                                   }
+                                               });
+    const auto planarNs =
+        Benchmark::nsPerItem(items, repetitions, [&] { bank.processBlock(in.data(), out.data(), numSamples); });
+    const auto interleavedNs = Benchmark::nsPerItem(
+        items, repetitions, [&] { bank.processFrames(interleavedIn.data(), interleavedOut.data(), numSamples); });
+    Benchmark::report(std::to_string(Channels) + " x Biquad", singleNs, "ns/sample/channel");
+    Benchmark::report("BiquadBank planar", planarNs, "ns/sample/channel");
+    Benchmark::report("BiquadBank interleaved", interleavedNs, "ns/sample/channel");
+    std::cout << std::flush;
+}
+
+template <AbacDsp::BiquadFilterType Type, size_t BlockSize>
+void testStateSpaceMatchesScalar(const float frequency, const float Q, const float gain)
+{
+    constexpr auto sampleRate{48000.f};
+    // tolerance relative to the signal level: the block expansion reorders the float operations, with poles close to
+    // z = 1 both paths drift by up to 1E-3 from a double precision reference
+    const auto tolerance = frequency < 100.f ? 2E-3f : 1E-4f;
+    AbacDsp::Biquad<Type> scalar;
+    AbacDsp::Biquad<Type, BlockSize> blocked;
+    scalar.computeCoefficients(sampleRate, frequency, Q, gain);
+    blocked.computeCoefficients(sampleRate, frequency, Q, gain);
+
+    std::vector<float> input(4801);
+    renderWithSineWave(input, sampleRate, 440.f);
+    input[0] += 1.f; // impulse for the transient
+    std::vector<float> expected(input.size());
+    std::vector<float> result(input.size());
+    // uneven chunks exercise the scalar tail and the state hand over between both paths
+    size_t pos = 0;
+    for (const size_t chunk : {1u, 7u, 64u, 13u, 1000u, 3u})
+    {
+        scalar.processBlock(input.data() + pos, expected.data() + pos, chunk);
+        blocked.processBlock(input.data() + pos, result.data() + pos, chunk);
+        pos += chunk;
+    }
+    scalar.processBlock(input.data() + pos, expected.data() + pos, input.size() - pos);
+    blocked.processBlock(input.data() + pos, result.data() + pos, input.size() - pos);
+    const auto peak = std::abs(*std::max_element(expected.begin(), expected.end(), [](const float a, const float b)
+                                                  { return std::abs(a) < std::abs(b); }));
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        ASSERT_NEAR(result[i], expected[i], tolerance * std::max(peak, 1.f))
+            << "at " << i << " f: " << frequency << " Q: " << Q;
+    }
+}
+
+template <size_t BlockSize>
+void testStateSpaceAllTypes()
+{
+    using enum AbacDsp::BiquadFilterType;
+    for (const float frequency : {30.f, 1000.f, 15000.f})
+    {
+        for (const float Q : {static_cast<float>(WeakQValue), static_cast<float>(StandardQValue), 5.f})
+        {
+            testStateSpaceMatchesScalar<LowPass, BlockSize>(frequency, Q, 0.f);
+            testStateSpaceMatchesScalar<HighPass, BlockSize>(frequency, Q, 0.f);
+            testStateSpaceMatchesScalar<BandPass, BlockSize>(frequency, Q, 0.f);
+            testStateSpaceMatchesScalar<Notch, BlockSize>(frequency, Q, 0.f);
+            testStateSpaceMatchesScalar<Peak, BlockSize>(frequency, Q, 12.f);
+            testStateSpaceMatchesScalar<Peak, BlockSize>(frequency, Q, -12.f);
+            testStateSpaceMatchesScalar<LoShelf, BlockSize>(frequency, Q, 6.f);
+            testStateSpaceMatchesScalar<HiShelf, BlockSize>(frequency, Q, -6.f);
+            testStateSpaceMatchesScalar<AllPass, BlockSize>(frequency, Q, 0.f);
+            testStateSpaceMatchesScalar<OnePole, BlockSize>(frequency, Q, 0.f);
+            testStateSpaceMatchesScalar<FreeCoefficients, BlockSize>(frequency, Q, 0.f);
+        }
+    }
+}
+
+TEST(DspBiquadStateSpaceTest, block4MatchesScalar)
+{
+    testStateSpaceAllTypes<4>();
+}
+
+TEST(DspBiquadStateSpaceTest, block8MatchesScalar)
+{
+    testStateSpaceAllTypes<8>();
+}
+
+TEST(DspBiquadStateSpaceTest, followsCoefficientChanges)
+{
+    constexpr auto sampleRate{48000.f};
+    AbacDsp::Biquad<AbacDsp::BiquadFilterType::FreeCoefficients> scalar;
+    AbacDsp::Biquad<AbacDsp::BiquadFilterType::FreeCoefficients, 8> blocked;
+    std::vector<float> input(512);
+    renderWithSineWave(input, sampleRate, 1000.f);
+    std::vector<float> expected(input.size());
+    std::vector<float> result(input.size());
+    for (const auto& cf : std::array<std::array<float, 5>, 3>{{{0.2f, 0.4f, 0.2f, -0.5f, 0.3f},
+                                                               {0.9f, -1.2f, 0.5f, -1.1f, 0.4f},
+                                                               {1.f, 0.f, 0.f, 0.f, 0.f}}})
+    {
+        scalar.setCoefficients(cf[0], cf[1], cf[2], cf[3], cf[4]);
+        blocked.setCoefficients(cf[0], cf[1], cf[2], cf[3], cf[4]);
+        scalar.processBlock(input.data(), expected.data(), input.size());
+        blocked.processBlock(input.data(), result.data(), input.size());
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            ASSERT_NEAR(result[i], expected[i], 1E-5f) << "at " << i;
+        }
+    }
+}
+
+TEST(DISABLED_DspBiquadStateSpaceTest, benchmarkMonoThroughput)
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr size_t numSamples{4096};
+    constexpr size_t repetitions{2000};
+    std::vector<float> input(numSamples);
+    std::vector<float> output(numSamples);
+    renderWithSineWave(input, sampleRate, 440.f);
+    AbacDsp::Biquad<AbacDsp::BiquadFilterType::Peak> scalar;
+    AbacDsp::Biquad<AbacDsp::BiquadFilterType::Peak, 4> block4;
+    AbacDsp::Biquad<AbacDsp::BiquadFilterType::Peak, 8> block8;
+    scalar.computeCoefficients(sampleRate, 1000.f, StandardQValue, 6.f);
+    block4.computeCoefficients(sampleRate, 1000.f, StandardQValue, 6.f);
+    block8.computeCoefficients(sampleRate, 1000.f, StandardQValue, 6.f);
+
+    auto measure = [&](auto& filter)
+    {
+        return Benchmark::nsPerItem(repetitions * numSamples, repetitions,
+                                    [&] { filter.processBlock(input.data(), output.data(), numSamples); });
+    };
+    Benchmark::report("Biquad scalar", measure(scalar));
+    Benchmark::report("Biquad block 4", measure(block4));
+    Benchmark::report("Biquad block 8", measure(block8));
+    std::cout << std::flush;
+}
+
+TEST(DspBiquadFastCoefficientsTest, matchExactDesign)
+{
+    using enum AbacDsp::BiquadFilterType;
+    constexpr auto sampleRate{48000.f};
+    for (const auto type : {LowPass, HighPass, BandPass, Notch, Peak, LoShelf, HiShelf, AllPass, FreeCoefficients})
+    {
+        for (float frequency = 20.f; frequency < 0.45f * sampleRate; frequency *= 1.1f)
+        {
+            for (const float Q : {static_cast<float>(WeakQValue), static_cast<float>(StandardQValue), 5.f,
+                                  static_cast<float>(StrongQvalue)})
+            {
+                for (const float gain : {-24.f, -6.f, 0.f, 3.f, 18.f})
+                {
+                    AbacDsp::BiquadCoefficients exact;
+                    AbacDsp::BiquadCoefficients fast;
+                    exact.coefficients(type, sampleRate, frequency, Q, gain);
+                    fast.fastCoefficients(type, sampleRate, frequency, Q, gain);
+                    const auto expected = exact.getCoefficients();
+                    const auto result = fast.getCoefficients();
+                    for (size_t i = 0; i < expected.size(); ++i)
+                    {
+                        ASSERT_NEAR(result[i], expected[i], 1E-5f * std::max(1.f, std::abs(expected[i])))
+                            << "type: " << static_cast<int>(type) << " coefficient: " << i << " f: " << frequency
+                            << " Q: " << Q << " gain: " << gain;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(DspBiquadFastCoefficientsTest, bankBulkUpdateMatchesSingleDesign)
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr size_t Lanes{8};
+    AbacDsp::BiquadBank<AbacDsp::BiquadFilterType::Peak, Lanes> bank;
+    std::array<float, Lanes> frequency{};
+    std::array<float, Lanes> Q{};
+    std::array<float, Lanes> gain{};
+    for (size_t lane = 0; lane < Lanes; ++lane)
+    {
+        frequency[lane] = 50.f * static_cast<float>(3 * lane + 1);
+        Q[lane] = 0.3f + 0.4f * static_cast<float>(lane);
+        gain[lane] = -12.f + 3.f * static_cast<float>(lane);
+    }
+    bank.computeCoefficientsFast(sampleRate, frequency.data(), Q.data(), gain.data());
+    for (size_t lane = 0; lane < Lanes; ++lane)
+    {
+        AbacDsp::Biquad<AbacDsp::BiquadFilterType::Peak> single;
+        single.computeCoefficientsFast(sampleRate, frequency[lane], Q[lane], gain[lane]);
+        const auto expected = single.getCoefficients();
+        const auto result = bank.getCoefficients(lane);
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            EXPECT_FLOAT_EQ(result[i], expected[i]) << "lane: " << lane << " coefficient: " << i;
+        }
+    }
+}
+
+TEST(DspBiquadFastCoefficientsTest, clampsToValidRange)
+{
+    AbacDsp::BiquadCoefficients sut;
+    for (const float frequency : {-100.f, 0.f, 24000.f, 1E6f})
+    {
+        sut.fastCoefficients(AbacDsp::BiquadFilterType::LowPass, 48000.f, frequency, StandardQValue, 0.f);
+        for (const auto c : sut.getCoefficients())
+        {
+            EXPECT_TRUE(std::isfinite(c)) << "f: " << frequency;
+        }
+    }
+}
+
+TEST(DISABLED_DspBiquadFastCoefficientsTest, benchmarkUpdatesPerSecond)
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr size_t Lanes{16};
+    constexpr size_t repetitions{20000};
+    std::array<float, Lanes> frequency{};
+    std::array<float, Lanes> Q{};
+    std::array<float, Lanes> gain{};
+    AbacDsp::BiquadBank<AbacDsp::BiquadFilterType::Peak, Lanes> bank;
+    std::array<AbacDsp::Biquad<AbacDsp::BiquadFilterType::Peak>, Lanes> singles;
+    float sum{0.f}; // keeps the designs from being optimized away
+
+    auto measure = [&](auto&& update)
+    {
+        auto step = [&](const size_t r)
+        {
+            for (size_t lane = 0; lane < Lanes; ++lane)
+            {
+                frequency[lane] = 100.f + static_cast<float>((r * Lanes + lane) % 10000);
+                Q[lane] = StandardQValue;
+                gain[lane] = static_cast<float>(lane) - 8.f;
+            }
+            update();
+            sum += bank.getCoefficients(r % Lanes)[0] + singles[r % Lanes].getCoefficients()[0];
+        };
+        return Benchmark::itemsPerSecond(repetitions * Lanes, repetitions, step);
+    };
+    const auto exact = measure(
+        [&]
+        {
+            for (size_t lane = 0; lane < Lanes; ++lane)
+            {
+                singles[lane].computeCoefficients(sampleRate, frequency[lane], Q[lane], gain[lane]);
+            }
+        });
+    const auto fast = measure(
+        [&]
+        {
+            for (size_t lane = 0; lane < Lanes; ++lane)
+            {
+                singles[lane].computeCoefficientsFast(sampleRate, frequency[lane], Q[lane], gain[lane]);
+            }
+        });
+    const auto bulk =
+        measure([&] { bank.computeCoefficientsFast(sampleRate, frequency.data(), Q.data(), gain.data()); });
+    std::cout << "exact design:         " << exact / 1E6 << " M updates/s\n";
+    std::cout << "fast design:          " << fast / 1E6 << " M updates/s\n";
+    std::cout << "BiquadBank bulk fast: " << bulk / 1E6 << " M updates/s (" << sum << ")" << std::endl;
+}
+
+TEST(DspBiquadDesignCacheTest, biquadDesignsThroughCache)
+{
+    AbacDsp::BiquadCoefficientCache<4> cache;
+    AbacDsp::Biquad<AbacDsp::BiquadFilterType::Peak> sut;
+    AbacDsp::Biquad<AbacDsp::BiquadFilterType::Peak> reference;
+    for (const float frequency : {1000.f, 2000.f, 1000.f, 1000.f, 2000.f})
+    {
+        sut.computeCoefficients(cache, 48000.f, frequency, StandardQValue, 6.f);
+        reference.computeCoefficients(48000.f, frequency, StandardQValue, 6.f);
+        EXPECT_EQ(sut.getCoefficients(), reference.getCoefficients());
+    }
+    // the repeated 1000 Hz is a no-op on the filter and doesn't reach the cache
+    EXPECT_EQ(cache.misses(), 2u);
+    EXPECT_EQ(cache.hits(), 2u);
+
+    // a second filter profits from the designs of the first
+    AbacDsp::Biquad<AbacDsp::BiquadFilterType::Peak> other;
+    other.computeCoefficients(cache, 48000.f, 2000.f, StandardQValue, 6.f);
+    EXPECT_EQ(other.getCoefficients(), reference.getCoefficients());
+    EXPECT_EQ(cache.hits(), 3u);
+}
+
+TEST(DspBiquadDesignCacheTest, setCoefficientsInvalidatesDesign)
+{
+    AbacDsp::Biquad<AbacDsp::BiquadFilterType::LowPass> sut;
+    sut.computeCoefficients(48000.f, 1000.f, StandardQValue, 0.f);
+    const auto designed = sut.getCoefficients();
+    sut.setCoefficients(1.f, 0.f, 0.f, 0.f, 0.f);
+    sut.computeCoefficients(48000.f, 1000.f, StandardQValue, 0.f);
+    EXPECT_EQ(sut.getCoefficients(), designed);
+    sut.computeCoefficientsFast(48000.f, 3000.f, StandardQValue, 0.f);
+    sut.computeCoefficients(48000.f, 1000.f, StandardQValue, 0.f);
+    EXPECT_EQ(sut.getCoefficients(), designed);
+}
+
+TEST(DspBiquadDesignCacheTest, chebyshevRestoresCachedDesigns)
+{
+    AbacDsp::ChebyshevBiquad sut;
+    auto designs = [](AbacDsp::ChebyshevBiquad& filter, const size_t step)
+    {
+        switch (step % 4)
+        {
+            case 0:
+                filter.computeType1(6, 1000, 3, true);
+                break;
+            case 1:
+                filter.computeType2(7, 2000, 3, false);
+                break;
+            case 2:
+                filter.computeType1(5, 500, 1, false);
+                break;
+            default:
+                filter.computeType2(4, 8000, 6, true);
+                break;
+        }
+    };
+    for (size_t step = 0; step < 12; ++step)
+    {
+        AbacDsp::ChebyshevBiquad reference;
+        designs(reference, step);
+        designs(sut, step);
+        designs(sut, step); // repeat: no-op
+        ASSERT_EQ(sut.elements(), reference.elements());
+        for (size_t i = 0; i < sut.elements(); ++i)
+        {
+            const auto a = sut.getCoefficients(i);
+            const auto b = reference.getCoefficients(i);
+            EXPECT_EQ(std::tie(a.b0, a.b1, a.b2, a.a1, a.a2), std::tie(b.b0, b.b1, b.b2, b.a1, b.a2));
+        }
+        for (const float frequency : {100.f, 1000.f, 10000.f})
+        {
+            EXPECT_EQ(sut.getMagnitudeInDb(frequency), reference.getMagnitudeInDb(frequency)) << "step " << step;
+        }
+    }
+    EXPECT_EQ(sut.getDesignCache().misses(), 4u);
+    EXPECT_EQ(sut.getDesignCache().hits(), 8u);
+}
+
+TEST(DISABLED_DspBiquadDesignCacheTest, benchmarkChebyshevAutomation)
+{
+    constexpr size_t repetitions{100000};
+    // automation toggling between a few settings
+    constexpr std::array<float, 4> cutoffs{500.f, 1000.f, 2000.f, 4000.f};
+    AbacDsp::ChebyshevBiquad cached;
+    std::array<AbacDsp::ChebyshevBiquad, 2> uncached; // alternating, so every design is a new one to the filter
+    const auto uncachedNs = Benchmark::nsPerItem(
+        repetitions, repetitions,
+        [&](const size_t r)
+        {
+            // a new fc each call, the cache can't help
+            uncached[r & 1].computeType1(12, 1000.f + static_cast<float>(r % 1000), 3, true);
+        });
+    const auto cachedNs = Benchmark::nsPerItem(
+        repetitions, repetitions,
+        [&](const size_t r)
+        {
+            cached.computeType1(12, cutoffs[r % cutoffs.size()], 3, true);
+        });
+    std::cout << "design:        " << uncachedNs << " ns\n";
+    std::cout << "cached design: " << cachedNs << " ns (hits " << cached.getDesignCache().hits() << ", misses "
+              << cached.getDesignCache().misses() << ")" << std::endl;
+}
+
+template <AbacDsp::BiquadFilterType type, float frequency, float gain>
+void checkFixedBiquadDesign()
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr auto Q{2.f};
+    using Fixed = AbacDsp::FixedBiquad<type, sampleRate, frequency, Q, gain>;
+    AbacDsp::Biquad<type> runtime;
+    runtime.computeCoefficients(sampleRate, frequency, Q, gain);
+    const auto expected = runtime.getCoefficients();
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_NEAR(Fixed::coefficients[i], expected[i], 1E-6f * std::max(1.f, std::abs(expected[i])))
+            << "type: " << static_cast<int>(type) << " coefficient: " << i << " f: " << frequency << " gain: " << gain;
+    }
+
+    Fixed fixed;
+    std::vector<float> in(1000);
+    renderWithSineWave(in, sampleRate, 997.);
+    std::vector<float> out(in.size());
+    std::vector<float> expectedOut(in.size());
+    fixed.processBlock(in.data(), out.data(), in.size());
+    runtime.processBlock(in.data(), expectedOut.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        ASSERT_NEAR(out[i], expectedOut[i], 1E-3f) << "type: " << static_cast<int>(type) << " sample: " << i;
+    }
+}
+
+template <AbacDsp::BiquadFilterType type>
+void checkFixedBiquadDesigns()
+{
+    checkFixedBiquadDesign<type, 20.f, 0.f>();
+    checkFixedBiquadDesign<type, 100.f, -12.f>();
+    checkFixedBiquadDesign<type, 1000.f, 6.f>();
+    checkFixedBiquadDesign<type, 10000.f, -3.f>();
+    checkFixedBiquadDesign<type, 20000.f, 12.f>();
+}
+
+TEST(DspBiquadConstexprDesignTest, biquadMatchesRuntimeDesign)
+{
+    using enum AbacDsp::BiquadFilterType;
+    static_assert(AbacDsp::designBiquad(Peak, 48000.f, 1000.f, 0.7f, 6.f)[0] > 1.f, "boosting peak filter");
+    checkFixedBiquadDesigns<LowPass>();
+    checkFixedBiquadDesigns<HighPass>();
+    checkFixedBiquadDesigns<BandPass>();
+    checkFixedBiquadDesigns<Notch>();
+    checkFixedBiquadDesigns<Peak>();
+    checkFixedBiquadDesigns<LoShelf>();
+    checkFixedBiquadDesigns<HiShelf>();
+    checkFixedBiquadDesigns<AllPass>();
+}
+
+template <size_t Order, float fc, float ripple, bool isLowPass, bool isType1>
+void checkFixedChebyshevDesign()
+{
+    constexpr auto sampleRate{48000.f};
+    using Fixed = AbacDsp::FixedChebyshev<Order, sampleRate, fc, ripple, isLowPass, isType1>;
+    AbacDsp::ChebyshevBiquad runtime;
+    runtime.setSampleRate(sampleRate);
+    if constexpr (isType1)
+    {
+        runtime.computeType1(Order, fc, ripple, isLowPass);
+    }
+    else
+    {
+        runtime.computeType2(Order, fc, ripple, isLowPass);
+    }
+    ASSERT_EQ(runtime.elements(), Fixed::ELEMENTS);
+    for (size_t i = 0; i < Fixed::ELEMENTS; ++i)
+    {
+        const auto a = Fixed::design.coefficients[i];
+        const auto b = runtime.getCoefficients(i);
+        for (const auto& [result, expected] : {std::pair{a.b0, b.b0}, std::pair{a.b1, b.b1}, std::pair{a.b2, b.b2},
+                                               std::pair{a.a1, b.a1}, std::pair{a.a2, b.a2}})
+        {
+            EXPECT_NEAR(result, expected, 1E-5f * std::max(1.f, std::abs(expected)))
+                << "order: " << Order << " fc: " << fc << " section: " << i;
+        }
+    }
+
+    Fixed fixed;
+    std::vector<float> in(2000);
+    renderWithSineWave(in, sampleRate, 1234.);
+    std::vector<float> out(in.size());
+    std::vector<float> expectedOut(in.size());
+    fixed.processBlock(in.data(), out.data(), in.size());
+    runtime.processBlock(in.data(), expectedOut.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        ASSERT_NEAR(out[i], expectedOut[i], 1E-3f) << "order: " << Order << " fc: " << fc << " sample: " << i;
+    }
+}
+
+TEST(DspBiquadConstexprDesignTest, chebyshevMatchesRuntimeDesign)
+{
+    static_assert(AbacDsp::FixedChebyshev<8, 96000.f, 20000.f, 0.5f, true>::design.coefficients[0].b0 > 0.f);
+    checkFixedChebyshevDesign<1, 1000.f, 1.f, true, true>();
+    checkFixedChebyshevDesign<4, 1000.f, 3.f, true, true>();
+    checkFixedChebyshevDesign<7, 500.f, 1.f, false, true>();
+    checkFixedChebyshevDesign<12, 4000.f, 0.5f, false, true>();
+    checkFixedChebyshevDesign<2, 2000.f, 3.f, true, false>();
+    checkFixedChebyshevDesign<5, 8000.f, 6.f, true, false>();
+    checkFixedChebyshevDesign<6, 300.f, 3.f, false, false>();
+    checkFixedChebyshevDesign<9, 2000.f, 1.f, false, false>();
+}
+
+template <AbacDsp::BiquadFilterType Type>
+void testStereoAudioBufferMatchesPlanar()
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr size_t numFrames{512};
+    std::vector<float> left(numFrames);
+    std::vector<float> right(numFrames);
+    renderWithSineWave(left, sampleRate, 440.);
+    renderWithSineWave(right, sampleRate, 3000.);
+    StereoAudioBuffer<numFrames> buffer;
+    buffer.mux({std::span<const float>{left}, std::span<const float>{right}});
+
+    AbacDsp::BiquadStereo<Type> planar;
+    AbacDsp::BiquadStereo<Type> sut;
+    planar.computeCoefficients(sampleRate, 1000.f, 2.f, 6.f);
+    sut.computeCoefficients(sampleRate, 1000.f, 2.f, 6.f);
+    planar.processBlock(left.data(), right.data(), left.data(), right.data(), numFrames);
+    sut.processBlock(buffer);
+    for (size_t i = 0; i < numFrames; ++i)
+    {
+        ASSERT_EQ(buffer(i, 0), left[i]) << "type " << static_cast<int>(Type) << " frame " << i;
+        ASSERT_EQ(buffer(i, 1), right[i]) << "type " << static_cast<int>(Type) << " frame " << i;
+    }
+}
+
+TEST(DspBiquadAudioBufferTest, stereoInPlaceMatchesPlanar)
+{
+    using enum AbacDsp::BiquadFilterType;
+    testStereoAudioBufferMatchesPlanar<LowPass>();
+    testStereoAudioBufferMatchesPlanar<HighPass>();
+    testStereoAudioBufferMatchesPlanar<BandPass>();
+    testStereoAudioBufferMatchesPlanar<Notch>();
+    testStereoAudioBufferMatchesPlanar<Peak>();
+    testStereoAudioBufferMatchesPlanar<LoShelf>();
+    testStereoAudioBufferMatchesPlanar<HiShelf>();
+    testStereoAudioBufferMatchesPlanar<AllPass>();
+}
+
+TEST(DspBiquadAudioBufferTest, chebyshevMultiChannelMatchesMono)
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr size_t numFrames{1024};
+    constexpr size_t Channels{6};
+    for (size_t order = 1; order <= AbacDsp::ChebyshevBiquad::MAX_ORDER; ++order)
+    {
+        for (const bool isType1 : {true, false})
+        {
+            for (const bool isLowPass : {true, false})
+            {
+                CH51AudioBuffer<numFrames> buffer;
+                AbacDsp::ChebyshevBiquadMultiChannel<Channels> sut;
+                sut.setSampleRate(sampleRate);
+                isType1 ? sut.computeType1(order, 2000.f, 1.f, isLowPass)
+                        : sut.computeType2(order, 2000.f, 1.f, isLowPass);
+                std::array<std::vector<float>, Channels> expected;
+                for (size_t ch = 0; ch < Channels; ++ch)
+                {
+                    expected[ch].resize(numFrames);
+                    renderWithSineWave(expected[ch], sampleRate, 300. * static_cast<double>(ch + 1));
+                    for (size_t i = 0; i < numFrames; ++i)
+                    {
+                        buffer(i, ch) = expected[ch][i];
+                    }
+                    AbacDsp::ChebyshevBiquad mono;
+                    mono.setSampleRate(sampleRate);
+                    isType1 ? mono.computeType1(order, 2000.f, 1.f, isLowPass)
+                            : mono.computeType2(order, 2000.f, 1.f, isLowPass);
+                    mono.processBlock(expected[ch].data(), expected[ch].data(), numFrames);
+                }
+                sut.processBlock(buffer);
+                // the mono cascade takes b2 == b0 for granted, the multichannel one uses the designed b2
+                for (size_t ch = 0; ch < Channels; ++ch)
+                {
+                    for (size_t i = 0; i < numFrames; ++i)
+                    {
+                        ASSERT_NEAR(buffer(i, ch), expected[ch][i], 1E-4f)
+                            << "order " << order << " type1 " << isType1 << " low pass " << isLowPass << " channel "
+                            << ch << " frame " << i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(DISABLED_DspBiquadAudioBufferTest, benchmarkInPlaceVersusDemux)
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr size_t numFrames{256};
+    constexpr size_t Channels{6};
+    constexpr size_t repetitions{4000};
+    CH51AudioBuffer<numFrames> source;
+    for (size_t ch = 0; ch < Channels; ++ch)
+    {
+        std::vector<float> wave(numFrames);
+        renderWithSineWave(wave, sampleRate, 200. * static_cast<double>(ch + 1));
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            source(i, ch) = wave[i];
+        }
+    }
+    std::array<AbacDsp::ChebyshevBiquad, Channels> singles;
+    for (auto& filter : singles)
+    {
+        filter.setSampleRate(sampleRate);
+        filter.computeType1(8, 4000.f, 1.f, true);
+    }
+    AbacDsp::ChebyshevBiquadMultiChannel<Channels> multiChannel;
+    multiChannel.setSampleRate(sampleRate);
+    multiChannel.computeType1(8, 4000.f, 1.f, true);
+
+    auto measure = [&](auto&& process)
+    {
+        float sink = 0;
+        const auto ns = Benchmark::nsPerItem(repetitions * numFrames * Channels, repetitions,
+                                             [&](const size_t r)
+                                             {
+                                                 auto buffer = source;
+                                                 process(buffer);
+                                                 sink += buffer(r % numFrames, r % Channels);
+                                             });
+        return std::pair{ns, sink};
+    };
+    std::array<std::array<float, numFrames>, Channels> planar;
+    const auto [demuxNs, demuxSink] = measure(
+        [&](CH51AudioBuffer<numFrames>& buffer)
+        {
+            std::array<std::span<float>, Channels> spans;
+            std::array<std::span<const float>, Channels> constSpans;
+            for (size_t ch = 0; ch < Channels; ++ch)
+            {
+                spans[ch] = planar[ch];
+                constSpans[ch] = planar[ch];
+            }
+            buffer.demux(spans);
+            for (size_t ch = 0; ch < Channels; ++ch)
+            {
+                singles[ch].processBlock(planar[ch].data(), planar[ch].data(), numFrames);
+            }
+            buffer.mux(constSpans);
+        });
+    const auto [inPlaceNs, inPlaceSink] = measure([&](CH51AudioBuffer<numFrames>& buffer)
+    {
+        multiChannel.processBlock(buffer);
+    });
+    std::cout << "8th order Chebyshev on 5.1, demux/filter/mux: " << demuxNs << " ns/sample/channel (" << demuxSink
+        << ")\n";
+    std::cout << "ChebyshevBiquadMultiChannel in place:        " << inPlaceNs << " ns/sample/channel ("
+        << inPlaceSink << ")" << std::endl;
+}
@@ -0,0 +1,181 @@
+#include "Filters/Biquad.h"
+#include "Filters/LadderFilter.h"
+#include "Filters/OnePoleFilter.h"
+#include "Filters/PinkFilter.h"
+#include "Numbers/Denormals.h"
+
+#include "BenchmarkTiming.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr float SampleRate{48000.f};
+constexpr size_t BlockSize{64};
+
+template <AbacDsp::DenormalPolicy Denormals>
+struct MakeBiquad
+{
+    auto operator()() const
+    {
+        AbacDsp::Biquad<AbacDsp::BiquadFilterType::LowPass, 1, Denormals> filter;
+        filter.computeCoefficients(SampleRate, 1000.f, 0.7071f, 0.f);
+        return filter;
+    }
+};
+
+template <AbacDsp::DenormalPolicy Denormals>
+struct MakeOnePole
+{
+    auto operator()() const
+    {
+        return AbacDsp::OnePoleFilter<AbacDsp::OnePoleFilterCharacteristic::LowPass, false, Denormals>(SampleRate,
+                                                                                                      500.f);
+    }
+};
+
+template <AbacDsp::DenormalPolicy Denormals>
+struct MakeFourStage
+{
+    auto operator()() const
+    {
+        AbacDsp::BasicFilter1Pole4StageSmooth<Denormals> filter(SampleRate);
+        filter.setCutoffFrequency(2000.f);
+        filter.setResonance(0.5f);
+        return filter;
+    }
+};
+
+template <AbacDsp::DenormalPolicy Denormals>
+struct MakePink
+{
+    auto operator()() const
+    {
+        return PinkFilter<Denormals>{};
+    }
+};
+
+// a noise burst followed by silence, the tail decays through the subnormal range
+std::vector<float> burstThenSilence(const size_t numSamples)
+{
+    std::vector<float> signal(numSamples, 0.f);
+    uint32_t seed{12345};
+    for (size_t i = 0; i < 2048; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        signal[i] = static_cast<float>(seed >> 8) / 8388608.f - 1.f;
+    }
+    return signal;
+}
+
+template <typename Filter>
+std::vector<float> render(Filter filter, const std::vector<float>& in)
+{
+    std::vector<float> out(in.size());
+    filter.processBlock(in.data(), out.data(), in.size());
+    return out;
+}
+
+template <template <AbacDsp::DenormalPolicy> typename Make>
+void checkFlushedTail(const char* name)
+{
+    const auto in = burstThenSilence(200000);
+    const auto expected = render(Make<AbacDsp::DenormalPolicy::None>{}(), in);
+    const auto result = render(Make<AbacDsp::DenormalPolicy::Flush>{}(), in);
+    auto isSubnormal = [](const float v)
+    {
+        return std::fpclassify(v) == FP_SUBNORMAL;
+    };
+    EXPECT_TRUE(std::ranges::any_of(expected, isSubnormal)) << name << ": the tail should reach subnormals unflushed";
+    EXPECT_FALSE(std::ranges::any_of(result, isSubnormal)) << name;
+    EXPECT_EQ(result.back(), 0.f) << name;
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        ASSERT_NEAR(result[i], expected[i], 1E-12f) << name << " sample " << i;
+    }
+}
+
+template <typename Filter>
+void measureDecay(Filter filter, const char* name, const bool noDenormals)
+{
+    const auto in = burstThenSilence(static_cast<size_t>(SampleRate) * 20);
+    std::vector<float> out(in.size());
+    std::optional<AbacDsp::ScopedNoDenormals> scope;
+    if (noDenormals)
+    {
+        scope.emplace();
+    }
+    double maxNs = 0;
+    double sumNs = 0;
+    size_t blocks = 0;
+    for (size_t i = 0; i + BlockSize <= in.size(); i += BlockSize)
+    {
+        const auto ns =
+            Benchmark::nsPerItem(1, 1, [&] { filter.processBlock(in.data() + i, out.data() + i, BlockSize); });
+        if (i > 4096) // skip the burst and warm up
+        {
+            maxNs = std::max(maxNs, ns);
+            sumNs += ns;
+            ++blocks;
+        }
+    }
+    const auto subnormals = std::ranges::count_if(out, [](const float v)
+    {
+        return std::fpclassify(v) == FP_SUBNORMAL;
+    });
+    std::cout << name << ": " << sumNs / static_cast<double>(blocks) << " ns/block mean, " << maxNs
+        << " ns/block max, " << subnormals << " subnormal outputs\n";
+}
+
+template <template <AbacDsp::DenormalPolicy> typename Make>
+void measureDecays(const char* name)
+{
+    const std::string label{name};
+    measureDecay(Make<AbacDsp::DenormalPolicy::None>{}(), (label + " none").c_str(), false);
+    measureDecay(Make<AbacDsp::DenormalPolicy::Flush>{}(), (label + " Flush").c_str(), false);
+    measureDecay(Make<AbacDsp::DenormalPolicy::None>{}(), (label + " ScopedNoDenormals").c_str(), true);
+}
+}
+
+TEST(DspDenormalPolicyTest, biquadFlushesTail)
+{
+    checkFlushedTail<MakeBiquad>("Biquad");
+}
+
+TEST(DspDenormalPolicyTest, biquadStateSpaceFlushesTail)
+{
+    AbacDsp::Biquad<AbacDsp::BiquadFilterType::LowPass, 4, AbacDsp::DenormalPolicy::Flush> sut;
+    sut.computeCoefficients(SampleRate, 1000.f, 0.7071f, 0.f);
+    const auto result = render(sut, burstThenSilence(200000));
+    EXPECT_EQ(result.back(), 0.f);
+}
+
+TEST(DspDenormalPolicyTest, onePoleFlushesTail)
+{
+    checkFlushedTail<MakeOnePole>("OnePoleFilter");
+}
+
+TEST(DspDenormalPolicyTest, fourStageFlushesTail)
+{
+    checkFlushedTail<MakeFourStage>("Filter1Pole4StageSmooth");
+}
+
+TEST(DspDenormalPolicyTest, pinkFlushesTail)
+{
+    checkFlushedTail<MakePink>("PinkFilter");
+}
+
+TEST(DISABLED_DspDenormalPolicyTest, benchmarkDecayingTail)
+{
+    measureDecays<MakeBiquad>("Biquad");
+    measureDecays<MakeOnePole>("OnePoleFilter");
+    measureDecays<MakeFourStage>("Filter1Pole4StageSmooth");
+    measureDecays<MakePink>("PinkFilter");
+    std::cout << std::flush;
+}
@@ -0,0 +1,54 @@
+#include "Filters/DesignCache.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+struct Key
+{
+    int a;
+    float b;
+
+    bool operator==(const Key&) const = default;
+};
+}
+
+TEST(DspDesignCacheTest, countsHitsAndMisses)
+{
+    AbacDsp::DesignCache<Key, int, 4> sut;
+    int designs = 0;
+    auto design = [&designs]
+    {
+        return ++designs;
+    };
+    EXPECT_EQ(sut.get({1, 0.5f}, design), 1);
+    EXPECT_EQ(sut.get({2, 0.5f}, design), 2);
+    EXPECT_EQ(sut.get({1, 0.5f}, design), 1);
+    EXPECT_EQ(sut.get({1, 0.25f}, design), 3);
+    EXPECT_EQ(designs, 3);
+    EXPECT_EQ(sut.hits(), 1u);
+    EXPECT_EQ(sut.misses(), 3u);
+    EXPECT_EQ(sut.size(), 3u);
+    sut.resetCounters();
+    EXPECT_EQ(sut.hits(), 0u);
+    EXPECT_EQ(sut.misses(), 0u);
+    EXPECT_EQ(sut.size(), 3u);
+}
+
+TEST(DspDesignCacheTest, replacesLeastRecentlyUsed)
+{
+    AbacDsp::DesignCache<Key, int, 2> sut;
+    sut.insert({1, 0.f}, 10);
+    sut.insert({2, 0.f}, 20);
+    ASSERT_NE(sut.find({1, 0.f}), nullptr); // 2 is now the oldest
+    sut.insert({3, 0.f}, 30);
+    EXPECT_EQ(sut.size(), 2u);
+    EXPECT_EQ(sut.find({2, 0.f}), nullptr);
+    ASSERT_NE(sut.find({1, 0.f}), nullptr);
+    EXPECT_EQ(*sut.find({1, 0.f}), 10);
+    ASSERT_NE(sut.find({3, 0.f}), nullptr);
+    EXPECT_EQ(*sut.find({3, 0.f}), 30);
+    sut.clear();
+    EXPECT_EQ(sut.size(), 0u);
+    EXPECT_EQ(sut.find({1, 0.f}), nullptr);
+}
@@ -0,0 +1,237 @@
+#include "Filters/FrequencyResponse.h"
+#include "Filters/Biquad.h"
+#include "Filters/LadderFilter.h"
+#include "Filters/OnePoleFilter.h"
+
+#include "BenchmarkTiming.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+std::complex<double> biquadResponse(const std::array<float, 5>& cf, const double frequency, const double sampleRate)
+{
+    const auto z1 = std::polar(1.0, -2 * std::numbers::pi * frequency / sampleRate);
+    const auto z2 = z1 * z1;
+    return (static_cast<double>(cf[0]) + static_cast<double>(cf[1]) * z1 + static_cast<double>(cf[2]) * z2) /
+           (1.0 + static_cast<double>(cf[3]) * z1 + static_cast<double>(cf[4]) * z2);
+}
+}
+
+TEST(DspFrequencyResponseTest, logarithmicGrid)
+{
+    const auto grid = AbacDsp::FrequencyGrid::logarithmic(48000.f, 20.f, 20000.f, 301);
+    ASSERT_EQ(grid.size(), 301u);
+    EXPECT_FLOAT_EQ(grid.frequencies().front(), 20.f);
+    EXPECT_FLOAT_EQ(grid.frequencies()[150], std::sqrt(20.f * 20000.f));
+    EXPECT_FLOAT_EQ(grid.frequencies().back(), 20000.f);
+    EXPECT_NEAR(grid.versine(2)[300], 1 - std::cos(2 * 2 * std::numbers::pi * 20000 / 48000), 1E-6);
+    EXPECT_NEAR(grid.sine(3)[300], std::sin(3 * 2 * std::numbers::pi * 20000 / 48000), 1E-6);
+}
+
+TEST(DspFrequencyResponseTest, biquadMatchesComplexEvaluation)
+{
+    using enum AbacDsp::BiquadFilterType;
+    constexpr auto sampleRate{48000.f};
+    const auto grid = AbacDsp::FrequencyGrid::logarithmic(sampleRate, 10.f, 23000.f, 512);
+    AbacDsp::FrequencyResponse response(grid);
+    std::vector<float> db(grid.size());
+    std::vector<float> phase(grid.size());
+    for (const auto type : {LowPass, HighPass, BandPass, Notch, Peak, LoShelf, HiShelf, AllPass})
+    {
+        for (const float frequency : {20.f, 200.f, 2000.f, 15000.f})
+        {
+            AbacDsp::BiquadCoefficients sut;
+            sut.coefficients(type, sampleRate, frequency, 2.f, 9.f);
+            response.reset();
+            sut.accumulateResponse(response);
+            response.magnitudeInDb(db.data());
+            response.phase(phase.data());
+            for (size_t i = 0; i < grid.size(); ++i)
+            {
+                const auto expected = biquadResponse(sut.getCoefficients(), grid.frequencies()[i], sampleRate);
+                const auto expectedDb = 20 * std::log10(std::abs(expected));
+                if (expectedDb < -80)
+                {
+                    continue; // notch center
+                }
+                ASSERT_NEAR(db[i], expectedDb, 0.01) << "type " << static_cast<int>(type) << " f " << frequency
+                    << " at " << grid.frequencies()[i];
+                if (expectedDb < -40)
+                {
+                    continue; // phase turns over within a few cents at the notch
+                }
+                const auto phaseError = std::remainder(phase[i] - std::arg(expected), 2 * std::numbers::pi);
+                ASSERT_NEAR(phaseError, 0, 5E-3) << "type " << static_cast<int>(type) << " f " << frequency << " at "
+                    << grid.frequencies()[i];
+            }
+        }
+    }
+}
+
+TEST(DspFrequencyResponseTest, chebyshevCascadeMatchesMagnitudeInDb)
+{
+    constexpr auto sampleRate{48000.f};
+    const auto grid = AbacDsp::FrequencyGrid::logarithmic(sampleRate, 20.f, 20000.f, 256);
+    AbacDsp::FrequencyResponse response(grid);
+    std::vector<float> db(grid.size());
+    AbacDsp::ChebyshevBiquad sut;
+    sut.setSampleRate(sampleRate);
+    for (size_t order = 1; order <= AbacDsp::ChebyshevBiquad::MAX_ORDER; ++order)
+    {
+        for (const bool isLowPass : {true, false})
+        {
+            sut.computeType1(order, 1000.f, 1.f, isLowPass);
+            response.reset();
+            sut.accumulateResponse(response);
+            response.magnitudeInDb(db.data());
+            for (size_t i = 0; i < grid.size(); ++i)
+            {
+                const auto expected = sut.getMagnitudeInDb(grid.frequencies()[i]);
+                if (expected > -60)
+                {
+                    ASSERT_NEAR(db[i], expected, 0.05) << "order " << order << " at " << grid.frequencies()[i];
+                }
+            }
+        }
+    }
+}
+
+template <AbacDsp::OnePoleFilterCharacteristic Characteristic>
+void checkOnePoleResponse()
+{
+    constexpr auto sampleRate{48000.f};
+    const auto grid = AbacDsp::FrequencyGrid::logarithmic(sampleRate, 20.f, 20000.f, 128);
+    AbacDsp::FrequencyResponse response(grid);
+    std::vector<float> magnitude(grid.size());
+    for (const float cutoff : {50.f, 500.f, 5000.f})
+    {
+        AbacDsp::OnePoleFilter<Characteristic> sut(sampleRate, cutoff);
+        response.reset();
+        sut.accumulateResponse(response);
+        response.magnitude(magnitude.data());
+        for (size_t i = 0; i < grid.size(); ++i)
+        {
+            const auto expected = sut.magnitude(grid.frequencies()[i]);
+            ASSERT_NEAR(magnitude[i], expected, 1E-3f * expected) << "cutoff " << cutoff << " at "
+                << grid.frequencies()[i];
+        }
+    }
+}
+
+TEST(DspFrequencyResponseTest, onePoleMatchesMagnitude)
+{
+    checkOnePoleResponse<AbacDsp::OnePoleFilterCharacteristic::LowPass>();
+    checkOnePoleResponse<AbacDsp::OnePoleFilterCharacteristic::HighPass>();
+    checkOnePoleResponse<AbacDsp::OnePoleFilterCharacteristic::HighPassLeaky>();
+    checkOnePoleResponse<AbacDsp::OnePoleFilterCharacteristic::AllPass>();
+}
+
+TEST(DspFrequencyResponseTest, ladderMatchesMagnitudeBP)
+{
+    constexpr auto sampleRate{48000.f};
+    const auto grid = AbacDsp::FrequencyGrid::logarithmic(sampleRate, 20.f, 20000.f, 128);
+    AbacDsp::FrequencyResponse response(grid);
+    std::vector<float> db(grid.size());
+    for (const auto& config : AbacDsp::poleMixingList)
+    {
+        AbacDsp::FourStageFilterTheoretical<float> sut(sampleRate, config.cf);
+        for (const float cutoff : {100.f, 1000.f, 8000.f})
+        {
+            for (const float resonance : {0.f, 1.f, 3.5f})
+            {
+                response.reset();
+                sut.accumulateResponse(response, cutoff, resonance);
+                response.magnitudeInDb(db.data());
+                for (size_t i = 0; i < grid.size(); ++i)
+                {
+                    const auto expected = 20 * std::log10(sut.magnitudeBP(cutoff, grid.frequencies()[i], resonance));
+                    if (expected > -60)
+                    {
+                        ASSERT_NEAR(db[i], expected, 0.02) << config.name << " cutoff " << cutoff << " resonance "
+                            << resonance << " at " << grid.frequencies()[i];
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(DspFrequencyResponseTest, cascadeMultipliesResponses)
+{
+    constexpr auto sampleRate{48000.f};
+    const auto grid = AbacDsp::FrequencyGrid::logarithmic(sampleRate, 20.f, 20000.f, 64);
+    AbacDsp::BiquadCoefficients peak;
+    AbacDsp::BiquadCoefficients shelf;
+    peak.coefficients(AbacDsp::BiquadFilterType::Peak, sampleRate, 1000.f, 1.f, 6.f);
+    shelf.coefficients(AbacDsp::BiquadFilterType::LoShelf, sampleRate, 200.f, 0.7f, -4.f);
+    AbacDsp::FrequencyResponse cascade(grid);
+    peak.accumulateResponse(cascade);
+    shelf.accumulateResponse(cascade);
+    AbacDsp::FrequencyResponse product(grid);
+    AbacDsp::FrequencyResponse shelfOnly(grid);
+    peak.accumulateResponse(product);
+    shelf.accumulateResponse(shelfOnly);
+    product.multiply(shelfOnly);
+    std::vector<float> a(grid.size());
+    std::vector<float> b(grid.size());
+    cascade.magnitudeInDb(a.data());
+    product.magnitudeInDb(b.data());
+    for (size_t i = 0; i < grid.size(); ++i)
+    {
+        EXPECT_NEAR(a[i], peak.magnitudeInDb(grid.frequencies()[i] / sampleRate) +
+                    shelf.magnitudeInDb(grid.frequencies()[i] / sampleRate), 0.01);
+        EXPECT_NEAR(a[i], b[i], 1E-5);
+    }
+}
+
+TEST(DISABLED_DspFrequencyResponseTest, benchmarkEqCurves)
+{
+    constexpr auto sampleRate{48000.f};
+    constexpr size_t Filters{32};
+    constexpr size_t Points{2048};
+    constexpr size_t Frames{60};
+    const auto grid = AbacDsp::FrequencyGrid::logarithmic(sampleRate, 20.f, 20000.f, Points);
+    std::vector<AbacDsp::BiquadCoefficients> filters(Filters);
+    for (size_t n = 0; n < Filters; ++n)
+    {
+        filters[n].coefficients(AbacDsp::BiquadFilterType::Peak, sampleRate, 30.f * static_cast<float>(n + 1), 2.f,
+                                static_cast<float>(n % 7) - 3.f);
+    }
+    std::vector<float> db(Points);
+    float sink = 0;
+
+    auto perPoint = [&](const size_t frame)
+    {
+        std::fill(db.begin(), db.end(), 0.f);
+        for (const auto& filter : filters)
+        {
+            for (size_t i = 0; i < Points; ++i)
+            {
+                db[i] += filter.magnitudeInDb(grid.frequencies()[i] / sampleRate);
+            }
+        }
+        sink += db[frame];
+    };
+    AbacDsp::FrequencyResponse response(grid);
+    auto batched = [&](const size_t frame)
+    {
+        response.reset();
+        for (const auto& filter : filters)
+        {
+            filter.accumulateResponse(response);
+        }
+        response.magnitudeInDb(db.data());
+        sink += db[frame];
+    };
+    const auto perPointNs = Benchmark::nsPerItem(Frames, Frames, perPoint);
+    const auto batchedNs = Benchmark::nsPerItem(Frames, Frames, batched);
+
+    Benchmark::report("per point magnitudeInDb", perPointNs * 1E-3, "us/frame");
+    Benchmark::report("FrequencyResponse", batchedNs * 1E-3, "us/frame");
+    std::cout << "(" << sink << ")" << std::endl;
+}
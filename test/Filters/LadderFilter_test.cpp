@@ -4,10 +4,14 @@
 #include <array>
 #include <cmath>
 #include <algorithm>
+#include <iostream>
+#include <numbers>
 #include <string_view>
 
 #include "Filters/LadderFilter.h"
 
+#include "BenchmarkTiming.h"
+
 
 class FilterTestFixture : public ::testing::Test
 {
@@ -122,4 +126,388 @@ TEST(LadderFilterTests, magnitudeFunction)
         const float digital = 20.0f * std::log10(sut.magnitudeBP(cutoff, f, 0.f));
         EXPECT_NEAR(analog, digital, 3.f) << "failed at " << f;
     }
-}
\ No newline at end of file
+}
+namespace
+{
+// a decaying saw per voice, detuned, so the voices see different signals
+std::vector<float> voiceSignal(const size_t voice, const size_t numSamples, const float sampleRate)
+{
+    std::vector<float> signal(numSamples);
+    const auto advance = 55.f * static_cast<float>(voice + 1) / sampleRate;
+    float phase = 0;
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        signal[i] = (2 * phase - 1) * std::exp(-static_cast<float>(i) / sampleRate);
+        phase += advance;
+        phase -= std::floor(phase);
+    }
+    return signal;
+}
+
+template <size_t Voices>
+void testBankMatchesSingleFilters()
+{
+    constexpr float sampleRate{48000.f};
+    constexpr size_t numSamples{4000};
+    AbacDsp::Filter1Pole4StageSmoothBank<Voices> sut(sampleRate);
+    std::array<std::vector<float>, Voices> signals;
+    std::array<std::vector<float>, Voices> expected;
+    std::array<const float*, Voices> in;
+    std::array<float*, Voices> out;
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        const auto mode = (voice * 7) % AbacDsp::poleMixingList.size();
+        const auto cutoff = 200.f * static_cast<float>(voice + 1);
+        const auto resonance = static_cast<float>(voice % 4);
+        AbacDsp::Filter1Pole4StageSmooth single(sampleRate);
+        single.setFilterCoefficients(AbacDsp::poleMixingList[mode].cf);
+        single.setCutoffFrequency(cutoff);
+        single.setResonance(resonance);
+        sut.setPoleMixing(voice, mode);
+        sut.setCutoffFrequency(voice, cutoff);
+        sut.setResonance(voice, resonance);
+
+        signals[voice] = voiceSignal(voice, numSamples, sampleRate);
+        expected[voice].resize(numSamples);
+        single.processBlock(signals[voice].data(), expected[voice].data(), numSamples);
+        in[voice] = signals[voice].data();
+        out[voice] = signals[voice].data();
+    }
+    sut.processBlock(in.data(), out.data(), numSamples);
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            // invSqrt instead of std::sqrt in compress(), rounding differs
+            ASSERT_NEAR(signals[voice][i], expected[voice][i], 1E-4f * std::max(1.f, std::abs(expected[voice][i])))
+                << "voice " << voice << " sample " << i;
+        }
+    }
+}
+
+// an exponential cutoff sweep (LFO or envelope) between 125 Hz and 8 kHz and a resonance sweep, different per voice
+std::vector<float> cutoffSweep(const size_t voice, const size_t numSamples, const float sampleRate)
+{
+    std::vector<float> cutoff(numSamples);
+    const auto w = 2 * std::numbers::pi_v<float> * 3.f * static_cast<float>(voice + 1) / sampleRate;
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        cutoff[i] = 1000.f * std::exp2(3.f * std::sin(w * static_cast<float>(i)));
+    }
+    return cutoff;
+}
+
+std::vector<float> resonanceSweep(const size_t voice, const size_t numSamples)
+{
+    std::vector<float> resonance(numSamples);
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        resonance[i] = 3.5f * static_cast<float>((i + voice * 97) % 1000) / 1000.f;
+    }
+    return resonance;
+}
+
+// without resonance buffers the resonance of setResonance() stays
+template <size_t Voices, bool ModulateResonance = true>
+void testBankModulationMatchesSingleFilters()
+{
+    constexpr float sampleRate{48000.f};
+    constexpr size_t numSamples{4000};
+    AbacDsp::Filter1Pole4StageSmoothBank<Voices> sut(sampleRate);
+    std::array<std::vector<float>, Voices> signals;
+    std::array<std::vector<float>, Voices> cutoffs;
+    std::array<std::vector<float>, Voices> resonances;
+    std::array<std::vector<float>, Voices> expected;
+    std::array<const float*, Voices> in;
+    std::array<const float*, Voices> cutoff;
+    std::array<const float*, Voices> resonance;
+    std::array<float*, Voices> out;
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        const auto mode = (voice * 7) % AbacDsp::poleMixingList.size();
+        AbacDsp::Filter1Pole4StageSmooth single(sampleRate);
+        single.setFilterCoefficients(AbacDsp::poleMixingList[mode].cf);
+        sut.setPoleMixing(voice, mode);
+        single.setResonance(0.3f * static_cast<float>(voice));
+        sut.setResonance(voice, 0.3f * static_cast<float>(voice));
+
+        signals[voice] = voiceSignal(voice, numSamples, sampleRate);
+        cutoffs[voice] = cutoffSweep(voice, numSamples, sampleRate);
+        resonances[voice] = resonanceSweep(voice, numSamples);
+        expected[voice].resize(numSamples);
+        if constexpr (ModulateResonance)
+        {
+            single.processBlock(signals[voice].data(), cutoffs[voice].data(), resonances[voice].data(),
+                                expected[voice].data(), numSamples);
+        }
+        else
+        {
+            single.processBlock(signals[voice].data(), cutoffs[voice].data(), expected[voice].data(), numSamples);
+        }
+        in[voice] = signals[voice].data();
+        cutoff[voice] = cutoffs[voice].data();
+        resonance[voice] = resonances[voice].data();
+        out[voice] = signals[voice].data();
+    }
+    if constexpr (ModulateResonance)
+    {
+        sut.processBlock(in.data(), cutoff.data(), resonance.data(), out.data(), numSamples);
+    }
+    else
+    {
+        sut.processBlock(in.data(), cutoff.data(), out.data(), numSamples);
+    }
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            ASSERT_NEAR(signals[voice][i], expected[voice][i], 1E-4f * std::max(1.f, std::abs(expected[voice][i])))
+                << "voice " << voice << " sample " << i;
+        }
+    }
+}
+
+template <size_t Voices>
+void measureModulatedVoices(const float sampleRate)
+{
+    constexpr size_t numSamples{256};
+    const size_t repetitions = static_cast<size_t>(sampleRate) * 4 / numSamples; // 4 seconds of audio
+    std::array<std::vector<float>, Voices> input;
+    std::array<std::vector<float>, Voices> cutoffs;
+    std::array<std::vector<float>, Voices> resonances;
+    std::array<std::vector<float>, Voices> output;
+    std::array<const float*, Voices> in;
+    std::array<const float*, Voices> cutoff;
+    std::array<const float*, Voices> resonance;
+    std::array<float*, Voices> out;
+    std::vector<AbacDsp::Filter1Pole4StageSmooth> singles(Voices, AbacDsp::Filter1Pole4StageSmooth(sampleRate));
+    AbacDsp::Filter1Pole4StageSmoothBank<Voices> bank(sampleRate);
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        input[voice] = voiceSignal(voice, numSamples, sampleRate);
+        cutoffs[voice] = cutoffSweep(voice, numSamples, sampleRate);
+        resonances[voice] = resonanceSweep(voice, numSamples);
+        output[voice].resize(numSamples);
+        in[voice] = input[voice].data();
+        cutoff[voice] = cutoffs[voice].data();
+        resonance[voice] = resonances[voice].data();
+        out[voice] = output[voice].data();
+    }
+    auto measure = [&](auto&& process)
+    {
+        return Benchmark::nsPerItem(repetitions * numSamples * Voices, repetitions, process);
+    };
+    const auto setters = measure(
+        [&]
+        {
+            for (size_t voice = 0; voice < Voices; ++voice)
+            {
+                auto& single = singles[voice];
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    single.setCutoffFrequency(cutoff[voice][i]);
+                    single.setResonance(resonance[voice][i]);
+                    out[voice][i] = single.step(in[voice][i]);
+                }
+            }
+        });
+    const auto buffers = measure(
+        [&]
+        {
+            for (size_t voice = 0; voice < Voices; ++voice)
+            {
+                singles[voice].processBlock(in[voice], cutoff[voice], resonance[voice], out[voice], numSamples);
+            }
+        });
+    const auto banked = measure(
+        [&] { bank.processBlock(in.data(), cutoff.data(), resonance.data(), out.data(), numSamples); });
+    std::cout << Voices << " modulated voices, ns per voice and sample: setters per sample " << setters
+        << ", modulation buffers " << buffers << ", bank " << banked << "\n";
+}
+
+template <typename Filter>
+void measureModeKernels(const std::string_view name, const float sampleRate)
+{
+    constexpr size_t numSamples{256};
+    const size_t repetitions = static_cast<size_t>(sampleRate) / numSamples; // 1 second of audio per mode
+    const auto in = voiceSignal(3, numSamples, sampleRate);
+    std::vector<float> out(numSamples);
+    Filter runtime(sampleRate);
+    Filter compiled(sampleRate);
+    runtime.setResonance(2.f);
+    compiled.setResonance(2.f);
+    double runtimeSeconds = 0;
+    double compiledSeconds = 0;
+    for (size_t mode = 0; mode < AbacDsp::poleMixingList.size(); ++mode)
+    {
+        runtime.setFilterCoefficients(AbacDsp::poleMixingList[mode].cf);
+        compiled.setPoleMixing(mode);
+        runtimeSeconds +=
+            Benchmark::seconds(repetitions, [&] { runtime.processBlock(in.data(), out.data(), numSamples); });
+        compiledSeconds +=
+            Benchmark::seconds(repetitions, [&] { compiled.processBlock(in.data(), out.data(), numSamples); });
+    }
+    const auto samples = static_cast<double>(repetitions * numSamples * AbacDsp::poleMixingList.size());
+    std::cout << name << ", all pole mixing modes, ns/sample: runtime weights " << runtimeSeconds * 1E9 / samples
+        << ", compiled mode kernels " << compiledSeconds * 1E9 / samples << " (" << out.back() << ")\n";
+}
+
+template <size_t Voices>
+void measureVoicesPerCore(const float sampleRate)
+{
+    constexpr size_t numSamples{256};
+    const size_t repetitions = static_cast<size_t>(sampleRate) * 4 / numSamples; // 4 seconds of audio
+    std::array<std::vector<float>, Voices> input;
+    std::array<std::vector<float>, Voices> output;
+    std::array<const float*, Voices> in;
+    std::array<float*, Voices> out;
+    std::vector<AbacDsp::Filter1Pole4StageSmooth> singles(Voices, AbacDsp::Filter1Pole4StageSmooth(sampleRate));
+    AbacDsp::Filter1Pole4StageSmoothBank<Voices> bank(sampleRate);
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        input[voice] = voiceSignal(voice, numSamples, sampleRate);
+        output[voice].resize(numSamples);
+        in[voice] = input[voice].data();
+        out[voice] = output[voice].data();
+        singles[voice].setFilterCoefficients(AbacDsp::poleMixingList[voice % 4].cf);
+        singles[voice].setCutoffFrequency(500.f * static_cast<float>(voice + 1));
+        singles[voice].setResonance(2.f);
+        bank.setPoleMixing(voice, voice % 4);
+        bank.setCutoffFrequency(voice, 500.f * static_cast<float>(voice + 1));
+        bank.setResonance(voice, 2.f);
+    }
+    auto measure = [&](auto&& process) { return Benchmark::voicesPerCore(4., Voices, repetitions, process); };
+    const auto singleVoices = measure(
+        [&]
+        {
+            for (size_t voice = 0; voice < Voices; ++voice)
+            {
+                singles[voice].processBlock(in[voice], out[voice], numSamples);
+            }
+        });
+    const auto bankVoices = measure([&] { bank.processBlock(in.data(), out.data(), numSamples); });
+    std::cout << Voices << " voices at " << sampleRate << " Hz, voices per core: " << Voices
+        << " x Filter1Pole4StageSmooth " << singleVoices << ", Filter1Pole4StageSmoothBank " << bankVoices << "\n";
+}
+}
+
+TEST(LadderFilterTests, bankMatchesSingleFilters)
+{
+    testBankMatchesSingleFilters<1>();
+    testBankMatchesSingleFilters<8>();
+    testBankMatchesSingleFilters<16>();
+}
+
+TEST(LadderFilterTests, bankResetsSingleVoice)
+{
+    constexpr float sampleRate{48000.f};
+    AbacDsp::Filter1Pole4StageSmoothBank<8> sut(sampleRate);
+    std::array<float, 8 * 64> frames;
+    frames.fill(0.5f);
+    sut.processFrames(frames.data(), frames.data(), 64);
+    sut.reset(3);
+    std::array<float, 8> silence{};
+    sut.processFrames(silence.data(), silence.data(), 1);
+    EXPECT_EQ(silence[3], 0.f);
+    EXPECT_NE(silence[2], 0.f);
+}
+
+TEST(LadderFilterTests, modeKernelsMatchRuntimeWeights)
+{
+    static_assert(AbacDsp::findFilterIndex("LP4") == 3);
+    constexpr float sampleRate{48000.f};
+    constexpr size_t numSamples{2000};
+    const auto in = voiceSignal(1, numSamples, sampleRate);
+    std::vector<float> expected(numSamples);
+    std::vector<float> out(numSamples);
+    for (size_t mode = 0; mode < AbacDsp::poleMixingList.size(); ++mode)
+    {
+        AbacDsp::Filter1Pole4StageSmooth runtime(sampleRate);
+        AbacDsp::Filter1Pole4StageSmooth sut(sampleRate);
+        for (auto* filter : {&runtime, &sut})
+        {
+            filter->setCutoffFrequency(1500.f);
+            filter->setResonance(3.f);
+        }
+        runtime.setFilterCoefficients(AbacDsp::poleMixingList[mode].cf);
+        sut.setPoleMixing(mode);
+        runtime.processBlock(in.data(), expected.data(), numSamples);
+        sut.processBlock(in.data(), out.data(), numSamples);
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            ASSERT_FLOAT_EQ(out[i], expected[i]) << AbacDsp::poleMixingList[mode].name << " sample " << i;
+        }
+    }
+}
+
+TEST(LadderFilterTests, modulationBuffersMatchPerSampleSetters)
+{
+    constexpr float sampleRate{48000.f};
+    constexpr size_t numSamples{8000};
+    const auto in = voiceSignal(2, numSamples, sampleRate);
+    const auto cutoff = cutoffSweep(0, numSamples, sampleRate);
+    const auto resonance = resonanceSweep(0, numSamples);
+    AbacDsp::Filter1Pole4StageSmooth expected(sampleRate);
+    AbacDsp::Filter1Pole4StageSmooth sut(sampleRate);
+    AbacDsp::Filter1Pole4StageSmooth cutoffOnly(sampleRate);
+    cutoffOnly.setResonance(2.f);
+    std::vector<float> out(numSamples);
+    std::vector<float> outCutoffOnly(numSamples);
+    sut.processBlock(in.data(), cutoff.data(), resonance.data(), out.data(), numSamples);
+    cutoffOnly.processBlock(in.data(), cutoff.data(), outCutoffOnly.data(), numSamples);
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        expected.setCutoffFrequency(cutoff[i]);
+        expected.setResonance(resonance[i]);
+        ASSERT_NEAR(out[i], expected.step(in[i]), 1E-4f) << "sample " << i;
+    }
+    AbacDsp::Filter1Pole4StageSmooth expectedCutoffOnly(sampleRate);
+    expectedCutoffOnly.setResonance(2.f);
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        expectedCutoffOnly.setCutoffFrequency(cutoff[i]);
+        ASSERT_NEAR(outCutoffOnly[i], expectedCutoffOnly.step(in[i]), 1E-4f) << "sample " << i;
+    }
+}
+
+TEST(LadderFilterTests, fastPoleMatchesSetCutoffFrequency)
+{
+    constexpr float sampleRate{48000.f};
+    for (float cutoff = 10.f; cutoff < 24000.f; cutoff *= 1.01f)
+    {
+        const auto x = AbacDsp::Filter1Pole4StageSmooth::adaptResonanceFrequency(cutoff);
+        const auto exact = std::exp(-std::numbers::pi * 2.0 * x / sampleRate);
+        const auto fast = AbacDsp::Filter1Pole4StageSmooth::cutoffToPoleFast(sampleRate, cutoff);
+        ASSERT_NEAR(fast, exact, 1E-6 * exact) << "cutoff " << cutoff;
+    }
+}
+
+TEST(LadderFilterTests, bankModulationMatchesSingleFilters)
+{
+    testBankModulationMatchesSingleFilters<1>();
+    testBankModulationMatchesSingleFilters<8>();
+    testBankModulationMatchesSingleFilters<16>();
+    testBankModulationMatchesSingleFilters<8, false>();
+}
+
+TEST(DISABLED_LadderFilterTests, benchmarkBankVoicesPerCore)
+{
+    measureVoicesPerCore<8>(48000.f);
+    measureVoicesPerCore<16>(48000.f);
+    std::cout << std::flush;
+}
+
+TEST(DISABLED_LadderFilterTests, benchmarkModulatedVoices)
+{
+    measureModulatedVoices<16>(48000.f);
+    measureModulatedVoices<64>(48000.f);
+    measureModulatedVoices<256>(48000.f);
+    std::cout << std::flush;
+}
+
+TEST(DISABLED_LadderFilterTests, benchmarkModeKernels)
+{
+    measureModeKernels<AbacDsp::Filter1Pole4StageSmooth>("sqrt", 48000.f);
+    measureModeKernels<AbacDsp::Filter1Pole4StageSaturated<AbacDsp::HardClipSaturator>>("hard clip", 48000.f);
+    std::cout << std::flush;
+}
@@ -1,11 +1,13 @@
 
 #include "Filters/OnePoleFilter.h"
 
+#include "BenchmarkTiming.h"
 #include "gtest/gtest.h"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <iostream>
 
 #include "NaiveGenerators/Generator.h"
 
@@ -129,3 +131,350 @@ TEST(DspOnePoleFilterTest, AllPassMatchTheoreticalMagnitudes)
 //         EXPECT_LT(input[i + 1], 0.0f);
 //     }
 // }
+
+template <AbacDsp::OnePoleFilterCharacteristic Characteristic>
+void testAudioBufferMatchesMono()
+{
+    constexpr float sampleRate{48000.f};
+    constexpr size_t numFrames{1000};
+    constexpr size_t Channels{6};
+    CH51AudioBuffer<numFrames> buffer;
+    StereoAudioBuffer<numFrames> stereoBuffer;
+    std::array<std::vector<float>, Channels> expected;
+    for (size_t ch = 0; ch < Channels; ++ch)
+    {
+        expected[ch].resize(numFrames);
+        NaiveDsp::Generator<NaiveDsp::Wave::Sine> sineWave{sampleRate, 200.f * static_cast<float>(ch + 1)};
+        sineWave.render(expected[ch].begin(), expected[ch].end());
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            buffer(i, ch) = expected[ch][i];
+            if (ch < 2)
+            {
+                stereoBuffer(i, ch) = expected[ch][i];
+            }
+        }
+        AbacDsp::OnePoleFilter<Characteristic> mono{sampleRate, 1500.f};
+        mono.processBlock(expected[ch].data(), numFrames);
+    }
+
+    AbacDsp::MultiChannelOnePoleFilter<Characteristic, Channels> sut{sampleRate, 1500.f};
+    sut.processBlock(buffer);
+    AbacDsp::OnePoleFilterStereo<Characteristic> stereo{sampleRate, 1500.f};
+    stereo.processBlock(stereoBuffer);
+    for (size_t ch = 0; ch < Channels; ++ch)
+    {
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            ASSERT_NEAR(buffer(i, ch), expected[ch][i], 1E-6f) << "type " << static_cast<int>(Characteristic)
+                << " channel " << ch << " frame " << i;
+            if (ch < 2)
+            {
+                ASSERT_NEAR(stereoBuffer(i, ch), expected[ch][i], 1E-6f) << "type " << static_cast<int>(Characteristic)
+                    << " stereo channel " << ch << " frame " << i;
+            }
+        }
+    }
+}
+
+TEST(DspOnePoleFilterTest, AudioBufferInPlaceMatchesMono)
+{
+    testAudioBufferMatchesMono<AbacDsp::OnePoleFilterCharacteristic::LowPass>();
+    testAudioBufferMatchesMono<AbacDsp::OnePoleFilterCharacteristic::HighPass>();
+    testAudioBufferMatchesMono<AbacDsp::OnePoleFilterCharacteristic::AllPass>();
+}
+
+namespace
+{
+// noise through a cutoff sweep from 20 Hz up to and past Nyquist
+template <AbacDsp::OnePoleFilterCharacteristic Characteristic>
+void testModulationMatchesSetCutoff()
+{
+    constexpr float sampleRate{48000.f};
+    constexpr size_t numFrames{6000};
+    constexpr size_t Channels{3};
+    std::vector<float> in(numFrames);
+    std::vector<float> cutoff(numFrames);
+    uint32_t seed{4711};
+    for (size_t i = 0; i < numFrames; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        in[i] = static_cast<float>(seed >> 8) / 8388608.f - 1.f;
+        cutoff[i] = 20.f * std::pow(1500.f, static_cast<float>(i) / (numFrames - 1000));
+    }
+    std::vector<float> expected(numFrames);
+    AbacDsp::OnePoleFilter<Characteristic> reference{sampleRate};
+    for (size_t i = 0; i < numFrames; ++i)
+    {
+        reference.setCutoff(cutoff[i]);
+        expected[i] = reference.step(in[i]);
+    }
+
+    std::vector<float> out(numFrames);
+    AbacDsp::OnePoleFilter<Characteristic> sut{sampleRate};
+    sut.processBlock(in.data(), cutoff.data(), out.data(), numFrames);
+    std::vector<float> left(in);
+    std::vector<float> right(in);
+    AbacDsp::OnePoleFilterStereo<Characteristic> stereo{sampleRate};
+    stereo.processBlock(left.data(), right.data(), cutoff.data(), left.data(), right.data(), numFrames);
+    std::vector<float> frames(numFrames * Channels);
+    for (size_t i = 0; i < numFrames; ++i)
+    {
+        std::fill_n(frames.data() + i * Channels, Channels, in[i]);
+    }
+    AbacDsp::MultiChannelOnePoleFilter<Characteristic, Channels> multiChannel{sampleRate};
+    multiChannel.processBlock(frames.data(), cutoff.data(), frames.data(), numFrames);
+    for (size_t i = 0; i < numFrames; ++i)
+    {
+        ASSERT_NEAR(out[i], expected[i], 1E-5f) << "type " << static_cast<int>(Characteristic) << " frame " << i;
+        ASSERT_EQ(frames[i * Channels + 2], out[i]) << "type " << static_cast<int>(Characteristic) << " frame " << i;
+        // the stereo filter has no leaky high pass
+        if constexpr (Characteristic != AbacDsp::OnePoleFilterCharacteristic::HighPassLeaky)
+        {
+            ASSERT_EQ(left[i], out[i]) << "type " << static_cast<int>(Characteristic) << " stereo frame " << i;
+            ASSERT_EQ(right[i], out[i]) << "type " << static_cast<int>(Characteristic) << " stereo frame " << i;
+        }
+    }
+}
+}
+
+TEST(DspOnePoleFilterTest, ModulationBuffersMatchSetCutoff)
+{
+    testModulationMatchesSetCutoff<AbacDsp::OnePoleFilterCharacteristic::LowPass>();
+    testModulationMatchesSetCutoff<AbacDsp::OnePoleFilterCharacteristic::HighPass>();
+    testModulationMatchesSetCutoff<AbacDsp::OnePoleFilterCharacteristic::HighPassLeaky>();
+    testModulationMatchesSetCutoff<AbacDsp::OnePoleFilterCharacteristic::AllPass>();
+}
+
+namespace
+{
+std::vector<float> noise(const size_t numSamples, const float amplitude)
+{
+    std::vector<float> signal(numSamples);
+    uint32_t seed{815};
+    for (auto& value : signal)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        value = amplitude * (static_cast<float>(seed >> 8) / 8388608.f - 1.f);
+    }
+    return signal;
+}
+
+template <AbacDsp::OnePoleFilterCharacteristic Characteristic, bool ClampValues, size_t BlockSize>
+void testScanMatchesRecursion()
+{
+    constexpr float sampleRate{48000.f};
+    // not a multiple of the block size, the rest runs step()
+    const auto in = noise(3 * 1024 + 5, ClampValues ? 3.f : 1.f);
+    for (const float cutoff : {20.f, 440.f, 5000.f, 18000.f})
+    {
+        AbacDsp::OnePoleFilter<Characteristic, ClampValues> expected{sampleRate, cutoff};
+        AbacDsp::OnePoleFilter<Characteristic, ClampValues, AbacDsp::DenormalPolicy::None, BlockSize> sut{sampleRate,
+                                                                                                          cutoff};
+        std::vector<float> reference(in.size());
+        std::vector<float> out(in);
+        // two calls, the state carries over
+        for (const size_t offset : {size_t{0}, in.size() / 2})
+        {
+            const auto count = offset == 0 ? in.size() / 2 : in.size() - in.size() / 2;
+            expected.processBlock(in.data() + offset, reference.data() + offset, count);
+            sut.processBlock(out.data() + offset, count);
+        }
+        for (size_t i = 0; i < in.size(); ++i)
+        {
+            ASSERT_NEAR(out[i], reference[i], 1E-5f * std::max(1.f, std::abs(reference[i])))
+                << "type " << static_cast<int>(Characteristic) << " clamp " << ClampValues << " block " << BlockSize
+                << " cutoff " << cutoff << " sample " << i;
+        }
+    }
+}
+
+template <AbacDsp::OnePoleFilterCharacteristic Characteristic>
+void testScanVariants()
+{
+    testScanMatchesRecursion<Characteristic, false, 8>();
+    testScanMatchesRecursion<Characteristic, false, 16>();
+    testScanMatchesRecursion<Characteristic, true, 8>();
+    testScanMatchesRecursion<Characteristic, true, 16>();
+}
+
+template <size_t BlockSize, AbacDsp::OnePoleFilterCharacteristic Characteristic>
+double measureNsPerSample(const std::vector<float>& in, std::vector<float>& out, const size_t blockSize)
+{
+    AbacDsp::OnePoleFilter<Characteristic, false, AbacDsp::DenormalPolicy::None, BlockSize> sut{48000.f, 1000.f};
+    const auto blocks = in.size() / blockSize;
+    return Benchmark::nsPerItem(blocks * blockSize, blocks,
+                                [&](const size_t block)
+                                {
+                                    const auto offset = block * blockSize;
+                                    sut.processBlock(in.data() + offset, out.data() + offset, blockSize);
+                                });
+}
+
+template <AbacDsp::OnePoleFilterCharacteristic Characteristic>
+void measureScan(const char* name)
+{
+    const auto in = noise(48000 * 20, 1.f);
+    std::vector<float> out(in.size());
+    for (size_t blockSize = 32; blockSize <= 4096; blockSize *= 2)
+    {
+        const auto scalar = measureNsPerSample<1, Characteristic>(in, out, blockSize);
+        const auto scan8 = measureNsPerSample<8, Characteristic>(in, out, blockSize);
+        const auto scan16 = measureNsPerSample<16, Characteristic>(in, out, blockSize);
+        std::cout << name << " block " << blockSize << ", ns/sample: recursion " << scalar << ", scan 8 " << scan8
+            << ", scan 16 " << scan16 << " (" << out[blockSize - 1] << ")\n";
+    }
+}
+}
+
+TEST(DspOnePoleFilterTest, ScanMatchesRecursion)
+{
+    testScanVariants<AbacDsp::OnePoleFilterCharacteristic::LowPass>();
+    testScanVariants<AbacDsp::OnePoleFilterCharacteristic::HighPass>();
+    testScanVariants<AbacDsp::OnePoleFilterCharacteristic::HighPassLeaky>();
+    testScanVariants<AbacDsp::OnePoleFilterCharacteristic::AllPass>();
+}
+
+TEST(DISABLED_DspOnePoleFilterTest, benchmarkScan)
+{
+    measureScan<AbacDsp::OnePoleFilterCharacteristic::LowPass>("low pass");
+    measureScan<AbacDsp::OnePoleFilterCharacteristic::AllPass>("all pass");
+    std::cout << std::flush;
+}
+
+namespace
+{
+// every channel with its own cutoff against one mono filter per channel. 20 channels step in chunks of 4 lanes.
+template <AbacDsp::OnePoleFilterCharacteristic Characteristic, size_t Channels, bool ClampValues>
+void testChannelCutoffsMatchMono()
+{
+    constexpr float sampleRate{48000.f};
+    constexpr size_t numFrames{1500};
+    const auto in = noise(numFrames * Channels, ClampValues ? 3.f : 1.f);
+    std::array<float, Channels> cutoffs;
+    for (size_t ch = 0; ch < Channels; ++ch)
+    {
+        cutoffs[ch] = 30.f * std::pow(1.4f, static_cast<float>(ch));
+    }
+    AbacDsp::MultiChannelOnePoleFilter<Characteristic, Channels, ClampValues> sut{sampleRate, 1000.f};
+    sut.setChannelCutoffs(cutoffs);
+    std::vector<float> out(in.size());
+    // the first half per channel, the second half again shared
+    sut.processBlock(in.data(), out.data(), numFrames / 2);
+    sut.setCutoff(1000.f);
+    sut.processBlock(in.data() + numFrames / 2 * Channels, out.data() + numFrames / 2 * Channels,
+                     numFrames - numFrames / 2);
+    for (size_t ch = 0; ch < Channels; ++ch)
+    {
+        AbacDsp::OnePoleFilter<Characteristic, ClampValues> mono{sampleRate, cutoffs[ch]};
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            if (i == numFrames / 2)
+            {
+                mono.setCutoff(1000.f);
+            }
+            ASSERT_NEAR(out[i * Channels + ch], mono.step(in[i * Channels + ch]), 1E-6f)
+                << "type " << static_cast<int>(Characteristic) << " channels " << Channels << " clamp " << ClampValues
+                << " channel " << ch << " frame " << i;
+        }
+    }
+}
+
+template <AbacDsp::OnePoleFilterCharacteristic Characteristic>
+void testChannelCutoffVariants()
+{
+    testChannelCutoffsMatchMono<Characteristic, 2, false>();
+    testChannelCutoffsMatchMono<Characteristic, 5, false>();
+    testChannelCutoffsMatchMono<Characteristic, 20, false>();
+    // the multichannel high pass clamps its output, the mono one only the state
+    if constexpr (Characteristic != AbacDsp::OnePoleFilterCharacteristic::HighPass)
+    {
+        testChannelCutoffsMatchMono<Characteristic, 2, true>();
+        testChannelCutoffsMatchMono<Characteristic, 20, true>();
+    }
+}
+
+template <size_t Channels, bool ClampValues>
+void measureMultiChannel()
+{
+    using enum AbacDsp::OnePoleFilterCharacteristic;
+    constexpr size_t numFrames{256};
+    constexpr size_t blockSize{64};
+    constexpr size_t repetitions{4000};
+    auto buffer = noise(numFrames * Channels, 1.f);
+    std::array<float, Channels> cutoffs;
+    for (size_t ch = 0; ch < Channels; ++ch)
+    {
+        cutoffs[ch] = 100.f + 10.f * static_cast<float>(ch);
+    }
+    auto measure = [&](auto&& processBlock)
+    {
+        return Benchmark::nsPerItem(repetitions * numFrames, repetitions,
+                                    [&]
+                                    {
+                                        for (size_t offset = 0; offset < numFrames; offset += blockSize)
+                                        {
+                                            processBlock(buffer.data() + offset * Channels);
+                                        }
+                                    });
+    };
+
+    AbacDsp::MultiChannelOnePoleFilter<LowPass, Channels, ClampValues> shared{48000.f, 500.f};
+    const auto sharedNs = measure([&](float* frames)
+    {
+        shared.processBlock(frames, blockSize);
+    });
+    AbacDsp::MultiChannelOnePoleFilter<LowPass, Channels, ClampValues> perChannel{48000.f};
+    perChannel.setChannelCutoffs(cutoffs);
+    const auto perChannelNs = measure([&](float* frames)
+    {
+        perChannel.processBlock(frames, blockSize);
+    });
+    // the alternative for per channel cutoffs: a mono filter per channel on deinterleaved buffers
+    std::vector<AbacDsp::OnePoleFilter<LowPass, ClampValues>> monos;
+    for (size_t ch = 0; ch < Channels; ++ch)
+    {
+        monos.emplace_back(48000.f, cutoffs[ch]);
+    }
+    std::vector<float> planar(blockSize * Channels);
+    const auto monoNs = measure([&](float* frames)
+    {
+        for (size_t ch = 0; ch < Channels; ++ch)
+        {
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                planar[ch * blockSize + i] = frames[i * Channels + ch];
+            }
+            monos[ch].processBlock(planar.data() + ch * blockSize, blockSize);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                frames[i * Channels + ch] = planar[ch * blockSize + i];
+            }
+        }
+    });
+    std::cout << Channels << " channels" << (ClampValues ? " clamped" : "") << ", ns/frame: shared cutoff "
+        << sharedNs << ", cutoff per channel " << perChannelNs << ", mono filters " << monoNs << " (" << buffer[7]
+        << ")\n";
+}
+}
+
+TEST(DspOnePoleFilterTest, ChannelCutoffsMatchMono)
+{
+    testChannelCutoffVariants<AbacDsp::OnePoleFilterCharacteristic::LowPass>();
+    testChannelCutoffVariants<AbacDsp::OnePoleFilterCharacteristic::HighPass>();
+    testChannelCutoffVariants<AbacDsp::OnePoleFilterCharacteristic::HighPassLeaky>();
+    testChannelCutoffVariants<AbacDsp::OnePoleFilterCharacteristic::AllPass>();
+}
+
+TEST(DISABLED_DspOnePoleFilterTest, benchmarkMultiChannel)
+{
+    measureMultiChannel<2, false>();
+    measureMultiChannel<8, false>();
+    measureMultiChannel<16, false>();
+    measureMultiChannel<64, false>();
+    measureMultiChannel<2, true>();
+    measureMultiChannel<8, true>();
+    measureMultiChannel<16, true>();
+    measureMultiChannel<64, true>();
+    std::cout << std::flush;
+}
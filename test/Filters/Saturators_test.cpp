@@ -0,0 +1,375 @@
+#include "Analysis/FftSmall.h"
+#include "Filters/Biquad.h"
+#include "Filters/LadderFilter.h"
+#include "Filters/Saturators.h"
+
+#include "BenchmarkTiming.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+// the exact curve of a policy as a policy, the reference for the filter output
+template <AbacDsp::Saturator S>
+struct ExactSaturator
+{
+    static float process(const float x)
+    {
+        return static_cast<float>(S::reference(x));
+    }
+
+    static double reference(const double x)
+    {
+        return S::reference(x);
+    }
+};
+
+template <AbacDsp::Saturator S>
+void checkCurve(const std::string_view name, const double maxError)
+{
+    for (int i = -20000; i <= 20000; ++i)
+    {
+        const auto x = static_cast<float>(i) / 1000.f;
+        const auto result = S::process(x);
+        ASSERT_NEAR(result, S::reference(x), maxError) << name << " x: " << x;
+        ASSERT_EQ(result, -S::process(-x)) << name << " is odd, x: " << x;
+        ASSERT_LE(std::abs(result), 1.f) << name << " x: " << x;
+    }
+    EXPECT_NEAR(S::process(1E6f), S::reference(1E6), maxError) << name;
+    EXPECT_NEAR(S::process(0.f), 0.f, maxError) << name;
+}
+
+// a saw with some drive, so the feedback path saturates
+std::vector<float> drivenSaw(const size_t numSamples, const float sampleRate)
+{
+    std::vector<float> signal(numSamples);
+    float phase = 0;
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        signal[i] = 3.f * (2 * phase - 1);
+        phase += 110.f / sampleRate;
+        phase -= std::floor(phase);
+    }
+    return signal;
+}
+
+// the limit of the ADAA quotients for nearly equal inputs is the curve itself
+template <AbacDsp::Saturator S, size_t Order>
+void checkAdaaSlowInput(const std::string_view name)
+{
+    AbacDsp::AdaaSaturator<S, Order> sut;
+    for (int i = -4000; i <= 4000; ++i)
+    {
+        const auto x = static_cast<float>(i) / 1000.f;
+        (void)sut.process(x);
+        (void)sut.process(x);
+        ASSERT_NEAR(sut.process(x), S::reference(x), 1E-5) << name << " order " << Order << " x: " << x;
+    }
+    // a slow ramp averages over the curve, up to the delay of half a sample per order (and rounds the hard clip kink)
+    for (int i = -4000 - static_cast<int>(Order); i <= 4000; ++i)
+    {
+        const auto x = static_cast<double>(i) / 1000.;
+        const auto result = sut.process(static_cast<float>(x));
+        if (i >= -4000)
+        {
+            ASSERT_NEAR(result, S::reference(x - 0.0005 * Order), 2E-4) << name << " order " << Order << " ramp x: "
+                << x;
+        }
+    }
+}
+
+template <AbacDsp::Saturator S>
+void checkAdaa(const std::string_view name)
+{
+    checkAdaaSlowInput<S, 1>(name);
+    if constexpr (AbacDsp::AntiderivativeSaturator<S, 2>)
+    {
+        checkAdaaSlowInput<S, 2>(name);
+    }
+}
+
+/*
+ * Alias measurement: a driven sine on an exact FFT bin through the resonant filter, in steady state the output is
+ * periodic in the FFT length and every bin apart from the harmonics is aliasing (no window needed).
+ */
+constexpr float AliasSampleRate{48000.f};
+constexpr size_t AliasLength{4096};
+constexpr size_t AliasBin{427}; // ~5 kHz, co-prime to the length so aliases don't land on harmonics
+constexpr size_t AliasSettle{16384};
+
+// driven far into the saturation
+std::vector<float> aliasTestSine(const size_t numSamples)
+{
+    std::vector<float> signal(numSamples);
+    const auto w = 2 * std::numbers::pi * AliasBin / static_cast<double>(AliasLength);
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        signal[i] = static_cast<float>(16 * std::sin(w * static_cast<double>(i % AliasLength)));
+    }
+    return signal;
+}
+
+template <typename Filter>
+Filter makeAliasTestFilter(const float sampleRate)
+{
+    Filter filter(sampleRate);
+    filter.setFilterCoefficients(AbacDsp::poleMixingList.front().cf);
+    filter.setCutoffFrequencyClean(3000.f);
+    filter.setResonance(3.2f);
+    filter.reset();
+    return filter;
+}
+
+// energy of the non harmonic bins below 20 kHz relative to the harmonics, in dB
+double aliasEnergyInDb(const std::vector<float>& signal)
+{
+    std::vector<std::complex<double>> in(AliasLength);
+    std::vector<std::complex<double>> spectrum(AliasLength);
+    for (size_t i = 0; i < AliasLength; ++i)
+    {
+        in[i] = signal[signal.size() - AliasLength + i];
+    }
+    KissFft<double>(AliasLength, false).compute(in.data(), spectrum.data());
+    const auto lastBin = static_cast<size_t>(20000.f / AliasSampleRate * AliasLength);
+    double harmonics = 0;
+    double aliases = 0;
+    for (size_t bin = 1; bin <= lastBin; ++bin)
+    {
+        (bin % AliasBin == 0 ? harmonics : aliases) += std::norm(spectrum[bin]);
+    }
+    return 10 * std::log10(aliases / harmonics);
+}
+
+template <typename Filter>
+std::vector<float> renderAtBaseRate(Filter sut)
+{
+    const auto in = aliasTestSine(AliasSettle + AliasLength);
+    std::vector<float> out(in.size());
+    sut.processBlock(in.data(), out.data(), in.size());
+    return out;
+}
+
+// the filter at Factor times the rate between two Chebyshev low passes, the costly way to reduce aliasing
+template <size_t Factor, typename Filter>
+class Oversampled
+{
+public:
+    explicit Oversampled(const float sampleRate)
+        : m_filter(makeAliasTestFilter<Filter>(sampleRate * Factor))
+        , m_up(Factor * MaxBlock)
+        , m_down(Factor * MaxBlock)
+    {
+        for (auto* lowPass : {&m_upFilter, &m_downFilter})
+        {
+            lowPass->setSampleRate(sampleRate * Factor);
+            lowPass->computeType1(10, 19000.f, 0.5f, true);
+        }
+    }
+
+    void processBlock(const float* in, float* out, const size_t numSamples)
+    {
+        for (size_t offset = 0; offset < numSamples; offset += MaxBlock)
+        {
+            const auto count = std::min(MaxBlock, numSamples - offset);
+            std::ranges::fill(m_up, 0.f);
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_up[i * Factor] = Factor * in[offset + i];
+            }
+            m_upFilter.processBlock(m_up.data(), m_up.data(), count * Factor);
+            m_filter.processBlock(m_up.data(), m_down.data(), count * Factor);
+            m_downFilter.processBlock(m_down.data(), m_down.data(), count * Factor);
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[offset + i] = m_down[i * Factor];
+            }
+        }
+    }
+
+private:
+    static constexpr size_t MaxBlock{64};
+    Filter m_filter;
+    AbacDsp::ChebyshevBiquad m_upFilter;
+    AbacDsp::ChebyshevBiquad m_downFilter;
+    std::vector<float> m_up;
+    std::vector<float> m_down;
+};
+
+template <AbacDsp::Saturator S>
+void checkAliasing(const std::string_view name)
+{
+    using Plain = AbacDsp::Filter1Pole4StageSaturated<S>;
+    auto measure = [](auto filter)
+    {
+        return aliasEnergyInDb(renderAtBaseRate(filter));
+    };
+    const auto plain = measure(makeAliasTestFilter<Plain>(AliasSampleRate));
+    const auto adaa1 = measure(makeAliasTestFilter<AbacDsp::Filter1Pole4StageAntialiased<S, 1>>(AliasSampleRate));
+    const auto adaa2 = measure(makeAliasTestFilter<AbacDsp::Filter1Pole4StageAntialiased<S, 2>>(AliasSampleRate));
+    const auto twice = measure(Oversampled<2, Plain>(AliasSampleRate));
+    const auto fourTimes = measure(Oversampled<4, Plain>(AliasSampleRate));
+    std::cout << name << " alias energy: plain " << plain << " dB, ADAA1 " << adaa1 << " dB, ADAA2 " << adaa2
+        << " dB, 2x " << twice << " dB, 4x " << fourTimes << " dB\n";
+    EXPECT_LT(adaa1, plain - 12) << name;
+    EXPECT_LT(adaa2, adaa1 - 8) << name;
+    EXPECT_LT(adaa1, twice) << name;
+    EXPECT_LT(adaa2, fourTimes) << name;
+}
+
+template <typename Filter>
+void measureCpu(Filter filter, const std::string_view name)
+{
+    const auto in = aliasTestSine(static_cast<size_t>(AliasSampleRate) * 4);
+    std::vector<float> out(in.size());
+    const auto ns = Benchmark::nsPerItem(in.size(), 1, [&] { filter.processBlock(in.data(), out.data(), in.size()); });
+    std::cout << name << ": " << ns << " ns/sample (" << out.back() << ")\n";
+}
+
+template <AbacDsp::Saturator S>
+void measurePolicy(const std::string_view name)
+{
+    constexpr float sampleRate{48000.f};
+    constexpr size_t numSamples{48000};
+    const auto in = drivenSaw(numSamples, sampleRate);
+    std::vector<float> out(numSamples);
+    std::vector<float> reference(numSamples);
+    double seconds = 0;
+    double squaredError = 0;
+    double squaredReference = 0;
+    for (const auto& mode : AbacDsp::poleMixingList)
+    {
+        AbacDsp::Filter1Pole4StageSaturated<S> sut(sampleRate);
+        AbacDsp::Filter1Pole4StageSaturated<ExactSaturator<S>> exact(sampleRate);
+        sut.setFilterCoefficients(mode.cf);
+        sut.setCutoffFrequency(2000.f);
+        sut.setResonance(3.f);
+        exact.setFilterCoefficients(mode.cf);
+        exact.setCutoffFrequency(2000.f);
+        exact.setResonance(3.f);
+        seconds += Benchmark::seconds(1, [&] { sut.processBlock(in.data(), out.data(), numSamples); });
+        exact.processBlock(in.data(), reference.data(), numSamples);
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            squaredError += (out[i] - reference[i]) * (out[i] - reference[i]);
+            squaredReference += reference[i] * reference[i];
+        }
+    }
+    double maxCurveError = 0;
+    for (int i = -8000; i <= 8000; ++i)
+    {
+        const auto x = static_cast<float>(i) / 1000.f;
+        maxCurveError = std::max(maxCurveError, std::abs(S::process(x) - S::reference(x)));
+    }
+    const auto samples = static_cast<double>(numSamples * AbacDsp::poleMixingList.size());
+    std::cout << name << ": " << seconds * 1E9 / samples << " ns/sample, curve error " << maxCurveError
+        << ", output deviation " << 10 * std::log10(squaredError / squaredReference + 1E-30) << " dB\n";
+}
+}
+
+TEST(DspSaturatorsTest, curvesMatchReference)
+{
+    checkCurve<AbacDsp::SqrtSaturator>("sqrt", 2E-7);
+    checkCurve<AbacDsp::FastSqrtSaturator>("fast sqrt", 5E-7);
+    checkCurve<AbacDsp::TanhSaturator>("tanh", 1E-6);
+    checkCurve<AbacDsp::AtanSaturator>("atan", 1E-6);
+    checkCurve<AbacDsp::CubicSaturator>("cubic", 2E-7);
+    checkCurve<AbacDsp::ReciprocalSaturator>("reciprocal", 2E-7);
+    checkCurve<AbacDsp::HardClipSaturator>("hard clip", 0);
+}
+
+TEST(DspSaturatorsTest, tanhSaturatesHugeInput)
+{
+    using Tanh = AbacDsp::TanhSaturator;
+    for (const auto x : {20.f, 1E10f, 3E9f, std::numeric_limits<float>::max(), std::numeric_limits<float>::infinity()})
+    {
+        EXPECT_EQ(Tanh::process(x), 1.f) << "x: " << x;
+        EXPECT_EQ(Tanh::process(-x), -1.f) << "x: " << -x;
+    }
+    EXPECT_EQ(std::abs(Tanh::process(std::numeric_limits<float>::quiet_NaN())), 1.f);
+
+    // a ladder driven far beyond any sane level stays finite
+    constexpr float sampleRate{48000.f};
+    auto in = drivenSaw(4800, sampleRate);
+    for (auto& x : in)
+    {
+        x *= 1E30f;
+    }
+    std::vector<float> out(in.size());
+    AbacDsp::Filter1Pole4StageSaturated<Tanh> sut(sampleRate);
+    sut.setResonance(4.f);
+    sut.processBlock(in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        ASSERT_TRUE(std::isfinite(out[i])) << "sample " << i;
+    }
+}
+
+TEST(DspSaturatorsTest, filterFollowsExactCurve)
+{
+    constexpr float sampleRate{48000.f};
+    const auto in = drivenSaw(4800, sampleRate);
+    std::vector<float> out(in.size());
+    std::vector<float> expected(in.size());
+    AbacDsp::Filter1Pole4StageSaturated<AbacDsp::TanhSaturator> sut(sampleRate);
+    AbacDsp::Filter1Pole4StageSaturated<ExactSaturator<AbacDsp::TanhSaturator>> exact(sampleRate);
+    sut.setResonance(2.f);
+    exact.setResonance(2.f);
+    sut.processBlock(in.data(), out.data(), in.size());
+    exact.processBlock(in.data(), expected.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        ASSERT_NEAR(out[i], expected[i], 1E-4f) << "sample " << i;
+    }
+}
+
+TEST(DspSaturatorsTest, adaaConvergesToCurve)
+{
+    checkAdaa<AbacDsp::SqrtSaturator>("sqrt");
+    checkAdaa<AbacDsp::TanhSaturator>("tanh");
+    checkAdaa<AbacDsp::AtanSaturator>("atan");
+    checkAdaa<AbacDsp::CubicSaturator>("cubic");
+    checkAdaa<AbacDsp::ReciprocalSaturator>("reciprocal");
+    checkAdaa<AbacDsp::HardClipSaturator>("hard clip");
+}
+
+// ADAA1 should reach 2x, ADAA2 4x oversampling
+TEST(DspSaturatorsTest, adaaReducesAliasing)
+{
+    checkAliasing<AbacDsp::SqrtSaturator>("sqrt");
+    checkAliasing<AbacDsp::HardClipSaturator>("hard clip");
+}
+
+TEST(DISABLED_DspSaturatorsTest, benchmarkPoliciesOverPoleMixingList)
+{
+    measurePolicy<AbacDsp::SqrtSaturator>("sqrt      ");
+    measurePolicy<AbacDsp::FastSqrtSaturator>("fast sqrt ");
+    measurePolicy<AbacDsp::TanhSaturator>("tanh      ");
+    measurePolicy<AbacDsp::AtanSaturator>("atan      ");
+    measurePolicy<AbacDsp::CubicSaturator>("cubic     ");
+    measurePolicy<AbacDsp::ReciprocalSaturator>("reciprocal");
+    measurePolicy<AbacDsp::HardClipSaturator>("hard clip ");
+    measurePolicy<ExactSaturator<AbacDsp::TanhSaturator>>("std::tanh ");
+    measurePolicy<ExactSaturator<AbacDsp::AtanSaturator>>("std::atan ");
+    std::cout << std::flush;
+}
+
+TEST(DISABLED_DspSaturatorsTest, benchmarkAdaaVersusOversampling)
+{
+    using Plain = AbacDsp::Filter1Pole4StageSmooth;
+    measureCpu(makeAliasTestFilter<Plain>(AliasSampleRate), "plain");
+    measureCpu(makeAliasTestFilter<AbacDsp::Filter1Pole4StageAntialiased<AbacDsp::SqrtSaturator, 1>>(AliasSampleRate),
+               "ADAA1");
+    measureCpu(makeAliasTestFilter<AbacDsp::Filter1Pole4StageAntialiased<AbacDsp::SqrtSaturator, 2>>(AliasSampleRate),
+               "ADAA2");
+    measureCpu(Oversampled<2, Plain>(AliasSampleRate), "2x   ");
+    measureCpu(Oversampled<4, Plain>(AliasSampleRate), "4x   ");
+    std::cout << std::flush;
+}
@@ -0,0 +1,194 @@
+#include "Generators/NoiseGenerator.h"
+#include "Filters/PinkFilter.h"
+#include "NaiveGenerators/Generator.h"
+
+#include "BenchmarkTiming.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr float SampleRate{48000.f};
+
+template <AbacDsp::NoiseColor Color, size_t Channels>
+std::vector<float> renderNoise(const size_t numFrames, const uint64_t seed = 1234)
+{
+    AbacDsp::NoiseGenerator<Color, Channels> sut{SampleRate, seed};
+    std::vector<float> out(numFrames * Channels);
+    // uneven blocks, the sequence continues across calls
+    for (size_t offset = 0; offset < numFrames;)
+    {
+        const auto count = std::min(numFrames - offset, size_t{61});
+        sut.render(out.data() + offset * Channels, count);
+        offset += count;
+    }
+    return out;
+}
+
+double rms(const std::vector<float>& signal)
+{
+    double sum = 0;
+    for (const auto v : signal)
+    {
+        sum += static_cast<double>(v) * v;
+    }
+    return std::sqrt(sum / static_cast<double>(signal.size()));
+}
+
+template <size_t Channels>
+void testColorsMatchReferenceFilters()
+{
+    using enum AbacDsp::NoiseColor;
+    constexpr size_t numFrames{20000};
+    const auto white = renderNoise<White, Channels>(numFrames);
+    const auto pink = renderNoise<Pink, Channels>(numFrames);
+    const auto brown = renderNoise<Brown, Channels>(numFrames);
+    AbacDsp::NoiseGenerator<BandLimited, Channels> bandLimited{SampleRate, 1234};
+    bandLimited.setCutoff(2000.f);
+    std::vector<float> band(numFrames * Channels);
+    bandLimited.render(band.data(), numFrames);
+    using Lowpass = AbacDsp::OnePoleFilter<AbacDsp::OnePoleFilterCharacteristic::LowPass>;
+    const auto brownPole = Lowpass::cutoffToFeedback(SampleRate, 8.f);
+    const auto brownGain = 0.25f * std::sqrt(3.f) * std::sqrt((1.f + brownPole) / (1.f - brownPole));
+    for (size_t ch = 0; ch < Channels; ++ch)
+    {
+        // the white noise of the same seed through the scalar filters
+        PinkFilter pinkFilter;
+        Lowpass brownFilter{SampleRate, 8.f};
+        Lowpass bandFilter{SampleRate, 2000.f};
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            const auto x = white[i * Channels + ch];
+            ASSERT_NEAR(pink[i * Channels + ch], pinkFilter.step(x), 1E-6f) << "channel " << ch << " frame " << i;
+            ASSERT_NEAR(brown[i * Channels + ch], brownFilter.step(brownGain * x), 1E-5f) << "channel " << ch
+                << " frame " << i;
+            ASSERT_NEAR(band[i * Channels + ch], bandFilter.step(x), 1E-6f) << "channel " << ch << " frame " << i;
+        }
+    }
+}
+
+template <AbacDsp::NoiseColor Color, size_t Channels>
+double measureNoise(std::vector<float>& buffer, const size_t blockFrames)
+{
+    AbacDsp::NoiseGenerator<Color, Channels> sut{SampleRate};
+    if constexpr (Color == AbacDsp::NoiseColor::BandLimited)
+    {
+        sut.setCutoff(5000.f);
+    }
+    return Benchmark::itemsPerSecond(buffer.size(), 1, [&]
+    {
+        for (size_t offset = 0; offset + blockFrames * Channels <= buffer.size(); offset += blockFrames * Channels)
+        {
+            sut.render(buffer.data() + offset, blockFrames);
+        }
+    });
+}
+
+template <size_t Channels>
+void measureChannels(std::vector<float>& buffer)
+{
+    using enum AbacDsp::NoiseColor;
+    constexpr size_t blockFrames{64};
+    // the scalar way: a Generator per channel (its noise is band limited), pink through PinkFilter
+    std::vector<NaiveDsp::Generator<NaiveDsp::Wave::Noise>> generators(
+        Channels, NaiveDsp::Generator<NaiveDsp::Wave::Noise>{SampleRate, 5000.f});
+    std::vector<PinkFilter<>> pinkFilters(Channels);
+    std::vector<float> channel(blockFrames);
+    auto measureGenerators = [&](const bool pink)
+    {
+        return Benchmark::itemsPerSecond(buffer.size(), 1, [&]
+        {
+            for (size_t offset = 0; offset + blockFrames * Channels <= buffer.size();
+                 offset += blockFrames * Channels)
+            {
+                for (size_t ch = 0; ch < Channels; ++ch)
+                {
+                    generators[ch].render(channel.begin(), channel.end());
+                    if (pink)
+                    {
+                        pinkFilters[ch].processBlock(channel.data(), blockFrames);
+                    }
+                    for (size_t i = 0; i < blockFrames; ++i)
+                    {
+                        buffer[offset + i * Channels + ch] = channel[i];
+                    }
+                }
+            }
+        });
+    };
+    std::cout << Channels << " channels, Msamples/s: Generator " << measureGenerators(false) * 1E-6
+        << ", Generator + PinkFilter " << measureGenerators(true) * 1E-6 << ", white "
+        << measureNoise<White, Channels>(buffer, blockFrames) * 1E-6 << ", pink "
+        << measureNoise<Pink, Channels>(buffer, blockFrames) * 1E-6 << ", brown "
+        << measureNoise<Brown, Channels>(buffer, blockFrames) * 1E-6 << ", band limited "
+        << measureNoise<BandLimited, Channels>(buffer, blockFrames) * 1E-6 << " (" << buffer[3] << ")\n";
+}
+}
+
+TEST(DspNoiseGeneratorTest, whiteIsUniformAndReproducible)
+{
+    const auto sut = renderNoise<AbacDsp::NoiseColor::White, 3>(100000);
+    EXPECT_EQ(sut, (renderNoise<AbacDsp::NoiseColor::White, 3>(100000)));
+    EXPECT_NE(sut, (renderNoise<AbacDsp::NoiseColor::White, 3>(100000, 4321)));
+    double mean = 0;
+    for (const auto v : sut)
+    {
+        ASSERT_GE(v, -1.f);
+        ASSERT_LT(v, 1.f);
+        mean += v;
+    }
+    EXPECT_NEAR(mean / static_cast<double>(sut.size()), 0, 0.01);
+    EXPECT_NEAR(rms(sut), 1 / std::sqrt(3.), 0.005);
+}
+
+TEST(DspNoiseGeneratorTest, channelsAreUncorrelated)
+{
+    constexpr size_t Channels{4};
+    constexpr size_t numFrames{50000};
+    for (const auto& sut : {renderNoise<AbacDsp::NoiseColor::White, Channels>(numFrames),
+                            renderNoise<AbacDsp::NoiseColor::Pink, Channels>(numFrames)})
+    {
+        for (size_t a = 0; a < Channels; ++a)
+        {
+            for (size_t b = a + 1; b < Channels; ++b)
+            {
+                double ab = 0, aa = 0, bb = 0;
+                for (size_t i = 0; i < numFrames; ++i)
+                {
+                    const double x = sut[i * Channels + a];
+                    const double y = sut[i * Channels + b];
+                    ab += x * y;
+                    aa += x * x;
+                    bb += y * y;
+                }
+                EXPECT_LT(std::abs(ab / std::sqrt(aa * bb)), 0.05) << "channels " << a << " and " << b;
+            }
+        }
+    }
+}
+
+TEST(DspNoiseGeneratorTest, colorsMatchReferenceFilters)
+{
+    testColorsMatchReferenceFilters<1>();
+    testColorsMatchReferenceFilters<5>();
+    testColorsMatchReferenceFilters<20>();
+}
+
+TEST(DspNoiseGeneratorTest, brownHasItsRms)
+{
+    const auto sut = renderNoise<AbacDsp::NoiseColor::Brown, 2>(480000);
+    EXPECT_NEAR(rms(sut), 0.25, 0.05);
+}
+
+TEST(DISABLED_DspNoiseGeneratorTest, benchmarkNoise)
+{
+    std::vector<float> buffer(1 << 20);
+    measureChannels<1>(buffer);
+    measureChannels<2>(buffer);
+    measureChannels<8>(buffer);
+    measureChannels<16>(buffer);
+    std::cout << std::flush;
+}
@@ -1,8 +1,12 @@
+#include "BenchmarkTiming.h"
 #include "gtest/gtest.h"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <iostream>
+#include <numbers>
+#include <vector>
 
 #include "NaiveGenerators/Generator.h"
 
@@ -125,3 +129,167 @@ TEST(NaiveGenerator, Noise_NoiseIsNotConstant)
     }
     EXPECT_FALSE(allSame);
 }
+
+namespace
+{
+template <NaiveDsp::Wave Style>
+std::vector<float> renderBlocks(const float frequency, const size_t numSamples, const size_t blockSize = 37)
+{
+    NaiveDsp::Generator<Style> gen(sampleRate, frequency);
+    std::vector<float> out(numSamples);
+    // uneven blocks, the phase continues across calls
+    for (size_t offset = 0; offset < numSamples;)
+    {
+        const auto count = std::min(numSamples - offset, blockSize);
+        gen.renderBlock(out.data() + offset, count);
+        offset += count;
+    }
+    return out;
+}
+
+// against the wave at the exact phase n * advance (of the float advance), skipping samples next to a saw wrap or a
+// square edge, which the rounding of the phase may move by a sample
+template <NaiveDsp::Wave Style>
+void testBlockAccuracy(const double maxError)
+{
+    for (const auto frequency : {50.f, 440.f, 3000.f, 15000.f})
+    {
+        constexpr size_t numSamples{48000};
+        const auto sut = renderBlocks<Style>(frequency, numSamples);
+        const auto advance = static_cast<double>(frequency / sampleRate);
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto phase = std::fmod(static_cast<double>(i) * advance, 1.);
+            double expected;
+            double edge = 1.;
+            if constexpr (Style == NaiveDsp::Wave::Sine)
+            {
+                expected = std::sin(2. * std::numbers::pi * phase);
+            }
+            else if constexpr (Style == NaiveDsp::Wave::Saw)
+            {
+                expected = 2. * (phase - 0.5);
+                edge = std::min(phase, 1. - phase);
+            }
+            else if constexpr (Style == NaiveDsp::Wave::Triangle)
+            {
+                expected = 2. * std::abs(2. * (phase - std::floor(phase + 0.5))) - 1.;
+            }
+            else
+            {
+                expected = phase < 0.5 ? 1. : -1.;
+                edge = std::min({phase, 1. - phase, std::abs(phase - 0.5)});
+            }
+            if (edge > 1E-4)
+            {
+                ASSERT_NEAR(sut[i], expected, maxError) << "frequency " << frequency << " sample " << i;
+            }
+        }
+    }
+}
+
+template <NaiveDsp::Wave Style>
+void testChannelLayouts()
+{
+    // the phase rounds by the split into blocks, a frequency without samples on the square edges
+    constexpr float frequency{1100.f};
+    constexpr size_t numFrames{300};
+    const auto mono = renderBlocks<Style>(frequency, numFrames, 100);
+    for (const size_t numChannels : {2u, 3u})
+    {
+        NaiveDsp::Generator<Style> interleaved(sampleRate, frequency);
+        std::vector<float> frames(numFrames * numChannels);
+        interleaved.renderBlock(frames.data(), 100, numChannels);
+        interleaved.renderBlock(frames.data() + 100 * numChannels, numFrames - 100, numChannels);
+
+        NaiveDsp::Generator<Style> planar(sampleRate, frequency);
+        std::vector<std::vector<float>> buffers(numChannels, std::vector<float>(numFrames));
+        std::vector<float*> channels;
+        for (auto& buffer : buffers)
+        {
+            channels.push_back(buffer.data());
+        }
+        planar.renderPlanar(channels.data(), numChannels, numFrames);
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                ASSERT_NEAR(frames[i * numChannels + ch], mono[i], 1E-5f) << numChannels << " channels, frame " << i;
+                ASSERT_NEAR(buffers[ch][i], mono[i], 1E-5f) << numChannels << " channels, frame " << i;
+            }
+        }
+    }
+}
+
+template <NaiveDsp::Wave Style>
+void measureWave(const char* name, std::vector<float>& buffer)
+{
+    constexpr size_t blockFrames{64};
+    auto samplesPerSecond = [&](auto&& render) { return Benchmark::itemsPerSecond(buffer.size(), 1, render); };
+    NaiveDsp::Generator<Style> gen(sampleRate, 440.f);
+    const auto steps = samplesPerSecond([&]
+    {
+        for (auto& v : buffer)
+        {
+            v = gen.step();
+        }
+    });
+    const auto mono = samplesPerSecond([&]
+    {
+        for (size_t offset = 0; offset + blockFrames <= buffer.size(); offset += blockFrames)
+        {
+            gen.renderBlock(buffer.data() + offset, blockFrames);
+        }
+    });
+    const auto stereo = samplesPerSecond([&]
+    {
+        for (size_t offset = 0; offset + 2 * blockFrames <= buffer.size(); offset += 2 * blockFrames)
+        {
+            gen.renderBlock(buffer.data() + offset, blockFrames, 2);
+        }
+    });
+    std::cout << name << ", Msamples/s: step " << steps * 1E-6 << ", block " << mono * 1E-6 << ", stereo block "
+              << stereo * 1E-6 << " (" << buffer[7] << ")\n";
+}
+}
+
+TEST(NaiveGenerator, BlockAccuracy)
+{
+    // the float phase drifts less than 1E-4 in a second (step() 5E-4), times the slope of the wave
+    constexpr double maxPhaseError{1E-4};
+    testBlockAccuracy<NaiveDsp::Wave::Sine>(2. * std::numbers::pi * maxPhaseError);
+    testBlockAccuracy<NaiveDsp::Wave::Saw>(2. * maxPhaseError);
+    testBlockAccuracy<NaiveDsp::Wave::Triangle>(4. * maxPhaseError);
+    testBlockAccuracy<NaiveDsp::Wave::Square>(0.);
+}
+
+TEST(NaiveGenerator, NoiseBlockMatchesStep)
+{
+    NaiveDsp::Generator<NaiveDsp::Wave::Noise> gen(sampleRate, 2000.f);
+    const auto sut = renderBlocks<NaiveDsp::Wave::Noise>(2000.f, 1000);
+    for (size_t i = 0; i < sut.size(); ++i)
+    {
+        ASSERT_NEAR(sut[i], gen.step(), 1E-6f) << "sample " << i;
+    }
+}
+
+TEST(NaiveGenerator, InterleavedAndPlanarMatchMono)
+{
+    testChannelLayouts<NaiveDsp::Wave::Sine>();
+    testChannelLayouts<NaiveDsp::Wave::Square>();
+    testChannelLayouts<NaiveDsp::Wave::Noise>();
+}
+
+TEST(DISABLED_NaiveGenerator, benchmarkBlockRendering)
+{
+    std::vector<float> buffer(1 << 16);
+    for (size_t pass = 0; pass < 4; ++pass)
+    {
+        measureWave<NaiveDsp::Wave::Sine>("Sine", buffer);
+        measureWave<NaiveDsp::Wave::Saw>("Saw", buffer);
+        measureWave<NaiveDsp::Wave::Triangle>("Triangle", buffer);
+        measureWave<NaiveDsp::Wave::Square>("Square", buffer);
+        measureWave<NaiveDsp::Wave::Noise>("Noise", buffer);
+    }
+    std::cout << std::flush;
+}
@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+
+#include "Numbers/Denormals.h"
+
+#include <cmath>
+#include <limits>
+
+
+TEST(DspDenormalsTests, flushDenormal)
+{
+    EXPECT_EQ(AbacDsp::flushDenormal(std::numeric_limits<float>::denorm_min()), 0.f);
+    EXPECT_EQ(AbacDsp::flushDenormal(-std::numeric_limits<float>::min() / 2), 0.f);
+    EXPECT_EQ(AbacDsp::flushDenormal(1E-16f), 0.f);
+    EXPECT_EQ(AbacDsp::flushDenormal(1E-14f), 1E-14f);
+    EXPECT_EQ(AbacDsp::flushDenormal(-0.5f), -0.5f);
+}
+
+TEST(DspDenormalsTests, flushDenormalsFollowsPolicy)
+{
+    float a = 1E-20f;
+    float b = 1.f;
+    AbacDsp::flushDenormals<AbacDsp::DenormalPolicy::None>(a, b);
+    EXPECT_EQ(a, 1E-20f);
+    AbacDsp::flushDenormals<AbacDsp::DenormalPolicy::Flush>(a, b);
+    EXPECT_EQ(a, 0.f);
+    EXPECT_EQ(b, 1.f);
+}
+
+TEST(DspDenormalsTests, scopedNoDenormalsRestoresMode)
+{
+    if constexpr (!AbacDsp::ScopedNoDenormals::isSupported())
+    {
+        GTEST_SKIP() << "no flush to zero mode on this platform";
+    }
+    volatile float small = std::numeric_limits<float>::min();
+    volatile float half = 0.5f;
+    EXPECT_EQ(std::fpclassify(small * half), FP_SUBNORMAL);
+    {
+        AbacDsp::ScopedNoDenormals noDenormals;
+        EXPECT_EQ(small * half, 0.f);
+        {
+            AbacDsp::ScopedNoDenormals nested;
+            EXPECT_EQ(small * half, 0.f);
+        }
+        EXPECT_EQ(small * half, 0.f);
+    }
+    EXPECT_EQ(std::fpclassify(small * half), FP_SUBNORMAL);
+}
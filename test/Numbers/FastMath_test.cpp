@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+
+#include "Numbers/FastMath.h"
+
+#include <cmath>
+#include <limits>
+
+
+TEST(DspFastMathTests, tanPi)
+{
+    for (int i = 0; i < 49990; ++i)
+    {
+        const auto x = static_cast<float>(i) / 100000.f;
+        const auto expected = std::tan(3.14159265358979323846 * static_cast<double>(x));
+        EXPECT_NEAR(FastMath::tanPi(x), expected, 3E-7 * std::max(expected, 1E-30)) << "x: " << x;
+    }
+}
+
+TEST(DspFastMathTests, exp2)
+{
+    for (int i = -126000; i <= 127000; i += 7)
+    {
+        const auto x = static_cast<float>(i) / 1000.f;
+        const auto expected = std::exp2(static_cast<double>(x));
+        EXPECT_NEAR(FastMath::exp2(x), expected, 3E-7 * expected) << "x: " << x;
+    }
+    // saturates outside
+    EXPECT_GT(FastMath::exp2(-200.f), 0.f);
+    EXPECT_TRUE(std::isfinite(FastMath::exp2(200.f)));
+    constexpr auto inf = std::numeric_limits<float>::infinity();
+    for (const auto x : {3E9f, 1E30f, std::numeric_limits<float>::max(), inf})
+    {
+        EXPECT_EQ(FastMath::exp2(x), FastMath::exp2(128.f)) << "x: " << x;
+        EXPECT_EQ(FastMath::exp2(-x), FastMath::exp2(-127.f)) << "x: " << -x;
+    }
+    EXPECT_GT(FastMath::exp2(-inf), 0.f);
+    EXPECT_TRUE(std::isfinite(FastMath::exp2(inf)));
+}
+
+TEST(DspFastMathTests, pow10)
+{
+    for (int i = -5000; i <= 5000; ++i)
+    {
+        const auto x = static_cast<float>(i) / 1000.f;
+        const auto expected = std::pow(10.0, static_cast<double>(x));
+        EXPECT_NEAR(FastMath::pow10(x), expected, 2E-6 * expected) << "x: " << x;
+    }
+    for (int i = -120; i <= 24; ++i)
+    {
+        const auto dB = static_cast<float>(i);
+        const auto expected = std::pow(10.0, static_cast<double>(dB) / 20);
+        EXPECT_NEAR(FastMath::dbToGain(dB), expected, 2E-6 * expected) << "dB: " << dB;
+    }
+}
+
+TEST(DspFastMathTests, clampPositive)
+{
+    EXPECT_EQ(FastMath::clampPositive(0.5f, 1.f, 2.f), 1.f);
+    EXPECT_EQ(FastMath::clampPositive(1.5f, 1.f, 2.f), 1.5f);
+    EXPECT_EQ(FastMath::clampPositive(3.f, 1.f, 2.f), 2.f);
+    EXPECT_EQ(FastMath::clampPositive(-3.f, 1.f, 2.f), 1.f);
+    EXPECT_EQ(FastMath::clampPositive(-0.f, 0.f, 2.f), 0.f);
+    EXPECT_EQ(FastMath::clampPositive(std::nanf(""), 1.f, 2.f), 2.f);
+}
+
+TEST(DspFastMathTests, log2)
+{
+    for (int i = -12000; i <= 12000; i += 3)
+    {
+        const auto x = std::pow(2.f, static_cast<float>(i) / 100.f);
+        const auto expected = std::log2(static_cast<double>(x));
+        EXPECT_NEAR(FastMath::log2(x), expected, 2E-7 * std::max(1., std::abs(expected))) << "x: " << x;
+    }
+    for (int i = 1; i <= 100000; ++i)
+    {
+        const auto x = static_cast<float>(i) / 1000.f;
+        const auto expected = std::log2(static_cast<double>(x));
+        EXPECT_NEAR(FastMath::log2(x), expected, 2E-7 * std::max(1., std::abs(expected))) << "x: " << x;
+    }
+    EXPECT_NEAR(FastMath::powerToDb(100.f), 20.f, 1E-5f);
+    EXPECT_NEAR(FastMath::powerToDb(0.f), -300.f, 1E-3f);
+}
+
+TEST(DspFastMathTests, invSqrt)
+{
+    for (int i = -12000; i <= 12000; i += 7)
+    {
+        const auto x = std::pow(2.f, static_cast<float>(i) / 100.f);
+        const auto expected = 1 / std::sqrt(static_cast<double>(x));
+        EXPECT_NEAR(FastMath::invSqrt(x), expected, 5E-7 * expected) << "x: " << x;
+    }
+}
+
+TEST(DspFastMathTests, atan2)
+{
+    for (int i = 0; i < 3600; ++i)
+    {
+        const auto angle = static_cast<double>(i) * 3.14159265358979323846 / 1800;
+        for (const double radius : {1E-6, 0.5, 1000.})
+        {
+            const auto y = static_cast<float>(radius * std::sin(angle));
+            const auto x = static_cast<float>(radius * std::cos(angle));
+            EXPECT_NEAR(FastMath::atan2(y, x), std::atan2(static_cast<double>(y), static_cast<double>(x)), 1E-6)
+                << "x: " << x << " y: " << y;
+        }
+    }
+    EXPECT_EQ(FastMath::atan2(0.f, 0.f), 0.f);
+}
+
+TEST(DspFastMathTests, sin2Pi)
+{
+    for (int i = -50000; i <= 400000; ++i)
+    {
+        const auto x = static_cast<float>(i) / 100000.f;
+        const auto expected = std::sin(2 * 3.14159265358979323846 * static_cast<double>(x));
+        EXPECT_NEAR(FastMath::sin2Pi(x), expected, 2E-7) << "x: " << x;
+    }
+}
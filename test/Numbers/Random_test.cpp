@@ -0,0 +1,180 @@
+#include "BenchmarkTiming.h"
+#include "gtest/gtest.h"
+
+#include "Numbers/Random.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+TEST(DspRandomTests, bitsToBipolarCoversTheRange)
+{
+    EXPECT_EQ(AbacDsp::bitsToBipolar(0u), -1.f);
+    EXPECT_EQ(AbacDsp::bitsToBipolar(0x80000000u), 0.f);
+    EXPECT_EQ(AbacDsp::bitsToBipolar(0xFFFFFFFFu), 1.f - 0x1p-22f);
+}
+
+// the reference xoshiro128+ for lane 0, seeded the same way
+TEST(DspRandomTests, lanesMatchScalarXoshiro)
+{
+    uint64_t seed{42};
+    const auto a = AbacDsp::splitMix64(seed);
+    const auto b = AbacDsp::splitMix64(seed);
+    std::array<uint32_t, 4> s{static_cast<uint32_t>(a), static_cast<uint32_t>(a >> 32), static_cast<uint32_t>(b),
+                              static_cast<uint32_t>(b >> 32) | 1u};
+    AbacDsp::RandomLanes<8> sut{42};
+    std::array<uint32_t, 8> lanes;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        const auto expected = s[0] + s[3];
+        const auto t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = (s[3] << 11) | (s[3] >> 21);
+        sut.next(lanes);
+        ASSERT_EQ(lanes[0], expected) << i;
+    }
+}
+
+TEST(DspRandomTests, fillBipolarIsUniformAndReproducible)
+{
+    constexpr size_t count{100003}; // not a multiple of the lanes
+    std::vector<float> sut(count);
+    std::vector<float> same(count);
+    AbacDsp::RandomLanes<8>{7}.fillBipolar(sut.data(), count);
+    AbacDsp::RandomLanes<8>{7}.fillBipolar(same.data(), count);
+    EXPECT_EQ(sut, same);
+    AbacDsp::RandomLanes<8>{8}.fillBipolar(same.data(), count);
+    EXPECT_NE(sut, same);
+
+    std::array<size_t, 10> histogram{};
+    double sum = 0;
+    for (const auto v : sut)
+    {
+        ASSERT_GE(v, -1.f);
+        ASSERT_LT(v, 1.f);
+        ++histogram[static_cast<size_t>((v + 1.f) * 5.f)];
+        sum += v;
+    }
+    EXPECT_NEAR(sum / count, 0., 0.01);
+    for (const auto bin : histogram)
+    {
+        EXPECT_NEAR(static_cast<double>(bin), count / 10., count / 100.);
+    }
+}
+
+TEST(DspRandomTests, fillBipolarDoesNotDependOnTheBlockSize)
+{
+    constexpr size_t count{1000};
+    std::vector<float> expected(count);
+    AbacDsp::RandomLanes<8>{3}.fillBipolar(expected.data(), count);
+    for (const size_t blockSize : {1u, 3u, 8u, 13u, 64u})
+    {
+        AbacDsp::RandomLanes<8> sut{3};
+        std::vector<float> out(count);
+        for (size_t offset = 0; offset < count; offset += blockSize)
+        {
+            sut.fillBipolar(out.data() + offset, std::min(blockSize, count - offset));
+        }
+        EXPECT_EQ(out, expected) << "block size " << blockSize;
+    }
+}
+
+// the jump is a polynomial in the step, both orders land on the same state
+TEST(DspRandomTests, jumpCommutesWithSteps)
+{
+    AbacDsp::RandomLanes<5> jumpFirst{11};
+    AbacDsp::RandomLanes<5> stepFirst{11};
+    std::array<uint32_t, 5> a;
+    std::array<uint32_t, 5> b;
+    jumpFirst.jump();
+    for (size_t i = 0; i < 100; ++i)
+    {
+        jumpFirst.next(a);
+        stepFirst.next(b);
+    }
+    stepFirst.jump();
+    for (size_t i = 0; i < 100; ++i)
+    {
+        jumpFirst.next(a);
+        stepFirst.next(b);
+        ASSERT_EQ(a, b) << i;
+    }
+}
+
+TEST(DspRandomTests, streamsAreReproducibleAndUncorrelated)
+{
+    constexpr size_t count{50000};
+    std::vector<std::vector<float>> streams(4, std::vector<float>(count));
+    for (size_t n = 0; n < streams.size(); ++n)
+    {
+        AbacDsp::RandomLanes<4>{5, n}.fillBipolar(streams[n].data(), count);
+    }
+    AbacDsp::RandomLanes<4> jumped{5};
+    jumped.jump();
+    jumped.jump();
+    std::vector<float> same(count);
+    jumped.fillBipolar(same.data(), count);
+    EXPECT_EQ(same, streams[2]);
+    for (size_t a = 0; a < streams.size(); ++a)
+    {
+        for (size_t b = a + 1; b < streams.size(); ++b)
+        {
+            double ab = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                ab += static_cast<double>(streams[a][i]) * streams[b][i];
+            }
+            // uniform in [-1, 1): the products have a variance of 1 / 9
+            EXPECT_LT(std::abs(ab / count), 4. / 3. / std::sqrt(count)) << "streams " << a << " and " << b;
+        }
+    }
+}
+
+namespace
+{
+template <typename Fill>
+double floatsPerSecond(std::vector<float>& buffer, Fill&& fill)
+{
+    constexpr size_t blockSize{64};
+    const auto blocks = buffer.size() / blockSize;
+    return Benchmark::itemsPerSecond(blocks * blockSize, blocks,
+                                     [&](const size_t block) { fill(buffer.data() + block * blockSize, blockSize); });
+}
+
+template <size_t Lanes>
+void measureLanes(std::vector<float>& buffer)
+{
+    AbacDsp::RandomLanes<Lanes> sut;
+    std::cout << "RandomLanes<" << Lanes << ">: " << sizeof(sut) << " bytes, "
+              << floatsPerSecond(buffer, [&](float* out, const size_t count) { sut.fillBipolar(out, count); }) * 1E-6
+              << " Mfloats/s\n";
+}
+}
+
+TEST(DISABLED_DspRandomTests, benchmarkAgainstMt19937)
+{
+    std::vector<float> buffer(1 << 16);
+    for (size_t pass = 0; pass < 8; ++pass)
+    {
+        std::mt19937 rng{1};
+        std::uniform_real_distribution<float> dist{-1.f, 1.f};
+        const auto reference = floatsPerSecond(buffer, [&](float* out, const size_t count)
+        {
+            std::generate_n(out, count, [&] { return dist(rng); });
+        });
+        std::cout << "mt19937: " << sizeof(rng) << " bytes, " << reference * 1E-6 << " Mfloats/s\n";
+        measureLanes<1>(buffer);
+        measureLanes<4>(buffer);
+        measureLanes<8>(buffer);
+        measureLanes<16>(buffer);
+    }
+    std::cout << buffer[5] << std::endl;
+}
@@ -0,0 +1,194 @@
+#include "Wavetables/WaveTableImport.h"
+#include "Wavetables/WaveTableOscillator.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <numbers>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// the cycles the BasicWave sets are made of
+float sineCycle(const size_t n)
+{
+    return std::sin(2.0f * std::numbers::pi_v<float> * static_cast<float>(n) / AbacDsp::WaveTableSize);
+}
+
+float sawCycle(const size_t n)
+{
+    return -1.0f + 2.0f * (static_cast<float>(n) / static_cast<float>(AbacDsp::WaveTableSize));
+}
+
+// 32 bit float, the samples come back as they are
+std::string writeWav(const std::string& name, const std::vector<float>& samples)
+{
+    const auto path = (std::filesystem::temp_directory_path() / name).string();
+    AudioFile<float> file;
+    file.setAudioBufferSize(1, static_cast<int>(samples.size()));
+    file.samples[0] = samples;
+    file.setBitDepth(32);
+    file.setSampleRate(48000);
+    EXPECT_TRUE(file.save(path));
+    return path;
+}
+
+template <typename Cycle>
+std::vector<float> cycles(const std::vector<Cycle>& waves)
+{
+    std::vector<float> samples;
+    for (const auto& wave : waves)
+    {
+        for (size_t n = 0; n < AbacDsp::WaveTableSize; ++n)
+        {
+            samples.push_back(wave(n));
+        }
+    }
+    return samples;
+}
+
+void expectSameTables(const AbacDsp::WaveTableSet& sut, const AbacDsp::WaveTableSet& expected)
+{
+    ASSERT_EQ(sut.tables.size(), expected.tables.size());
+    EXPECT_EQ(std::memcmp(sut.tables.data(), expected.tables.data(), expected.tables.size_bytes()), 0);
+}
+
+std::vector<float> render(AbacDsp::WaveTableOscillator& osc, const size_t numSamples)
+{
+    std::vector<float> out(numSamples);
+    osc.processBlock(out.data(), numSamples);
+    return out;
+}
+}
+
+TEST(WaveTableImport, framesAreTheBasicWaveSets)
+{
+    const auto path = writeWav("WaveTableImportFrames.wav", cycles<float (*)(size_t)>({sineCycle, sawCycle}));
+    AbacDsp::UserWaveTableSlot slot;
+    ASSERT_TRUE(AbacDsp::importWaveTable(slot, path));
+    const AbacDsp::UserWaveTableRef sut{slot};
+    expectSameTables(*sut.frame(0), AbacDsp::WaveTableStore::getTableSet(AbacDsp::BasicWave::Sine));
+    expectSameTables(*sut.frame(1), AbacDsp::WaveTableStore::getTableSet(AbacDsp::BasicWave::Saw));
+    // frames beyond the last play the last
+    EXPECT_EQ(sut.frame(7), sut.frame(1));
+    std::filesystem::remove(path);
+}
+
+TEST(WaveTableImport, singleCycleIsStretched)
+{
+    // shorter and longer than a table, the longer one with a harmonic above WaveTableSize / 2 that must not alias
+    for (const size_t length : {size_t{600}, size_t{3001}})
+    {
+        std::vector<float> samples(length);
+        for (size_t n = 0; n < length; ++n)
+        {
+            const auto phase = 2.0f * std::numbers::pi_v<float> * static_cast<float>(n) / static_cast<float>(length);
+            samples[n] = std::sin(phase) + (length > AbacDsp::WaveTableSize ? 0.5f * std::sin(1400.f * phase) : 0.f);
+        }
+        const auto path = writeWav("WaveTableImportSingle.wav", samples);
+        AbacDsp::UserWaveTableSlot slot;
+        ASSERT_TRUE(AbacDsp::importWaveTable(slot, path));
+        const AbacDsp::UserWaveTableRef sut{slot};
+        const auto& sine = AbacDsp::WaveTableStore::getTableSet(AbacDsp::BasicWave::Sine);
+        ASSERT_EQ(sut.frame(0)->tables.size(), sine.tables.size());
+        for (size_t i = 0; i < AbacDsp::WaveTableSize; ++i)
+        {
+            ASSERT_NEAR(sut.frame(0)->tables[0].data[i], sine.tables[0].data[i], 1E-3f)
+                << "length " << length << " sample " << i;
+        }
+        std::filesystem::remove(path);
+    }
+}
+
+TEST(WaveTableImport, unreadableFileKeepsTheTable)
+{
+    AbacDsp::UserWaveTableSlot slot;
+    EXPECT_FALSE(AbacDsp::importWaveTable(slot, "does/not/exist.wav"));
+    EXPECT_EQ(slot.version(), 0);
+    AbacDsp::WaveTableImporter importer;
+    EXPECT_FALSE(importer.importAsync(slot, "does/not/exist.wav").get());
+    EXPECT_EQ(slot.version(), 0);
+}
+
+TEST(WaveTableImport, oscillatorSwapsInThePublishedTable)
+{
+    const auto path = writeWav("WaveTableImportSwap.wav", cycles<float (*)(size_t)>({sawCycle}));
+    AbacDsp::UserWaveTableSlot slot;
+    AbacDsp::WaveTableOscillator sut{48000.f};
+    AbacDsp::WaveTableOscillator sine{48000.f};
+    AbacDsp::WaveTableOscillator saw{48000.f};
+    for (auto* osc : {&sut, &sine, &saw})
+    {
+        osc->setFrequency(440.f);
+        osc->setMorph(-1.f);
+    }
+    sine.setWaveset(0, AbacDsp::BasicWave::Sine);
+    saw.setWaveset(0, AbacDsp::BasicWave::Saw);
+    sut.setUserWaveset(0, slot);
+    // nothing published yet: a sine
+    const auto before = render(sut, 300);
+    EXPECT_EQ(before, render(sine, 300));
+    render(saw, 300);
+
+    AbacDsp::WaveTableImporter importer;
+    ASSERT_TRUE(importer.importAsync(slot, path).get());
+    EXPECT_EQ(render(sut, 300), render(saw, 300));
+    std::filesystem::remove(path);
+}
+
+TEST(WaveTableImport, replacedTablesAreDeletedOnceReleased)
+{
+    AbacDsp::UserWaveTableSlot slot;
+    auto publish = [&](float (*cycle)(size_t))
+    {
+        std::vector<std::vector<float>> frames{cycles<float (*)(size_t)>({cycle})};
+        slot.publish(AbacDsp::makeUserWaveTable(frames));
+    };
+    publish(sineCycle);
+    AbacDsp::WaveTableOscillator osc{48000.f};
+    osc.setUserWaveset(1, slot);
+    auto copy = osc; // holds the table as well
+    publish(sawCycle);
+    EXPECT_EQ(slot.numRetired(), 1);
+    render(osc, 64);
+    slot.collect();
+    EXPECT_EQ(slot.numRetired(), 1);
+    render(copy, 64);
+    slot.collect();
+    EXPECT_EQ(slot.numRetired(), 0);
+}
+
+TEST(WaveTableImport, publishWhileOscillatorsPlay)
+{
+    AbacDsp::UserWaveTableSlot slot;
+    std::atomic<bool> done{false};
+    std::thread audio(
+        [&]
+        {
+            AbacDsp::WaveTableOscillator osc{48000.f};
+            osc.setFrequency(220.f);
+            osc.setUserWaveset(0, slot);
+            osc.setMorph(-1.f);
+            std::vector<float> out(64);
+            while (!done)
+            {
+                osc.processBlock(out.data(), out.size());
+                for (const auto v : out)
+                {
+                    ASSERT_LE(std::abs(v), 1.1f); // the saw set peaks at 1.05
+                }
+            }
+        });
+    for (size_t i = 0; i < 20; ++i)
+    {
+        std::vector<std::vector<float>> frames{cycles<float (*)(size_t)>({i % 2 ? sawCycle : sineCycle})};
+        slot.publish(AbacDsp::makeUserWaveTable(frames));
+    }
+    done = true;
+    audio.join();
+    slot.collect();
+    EXPECT_EQ(slot.numRetired(), 0);
+}
@@ -0,0 +1,193 @@
+#include "Wavetables/WaveTableOscillatorBank.h"
+
+#include "BenchmarkTiming.h"
+#include "gtest/gtest.h"
+
+#include <array>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr float SampleRate{48000.f};
+
+// every voice something else: waves, pitch (several table levels) and morph between and across the wavesets
+template <typename Osc>
+void setupVoice(Osc&& setWaveset, const size_t voice)
+{
+    constexpr std::array waves{AbacDsp::BasicWave::Sine, AbacDsp::BasicWave::Triangle, AbacDsp::BasicWave::Square,
+                               AbacDsp::BasicWave::Saw};
+    setWaveset(0, waves[voice % waves.size()]);
+    setWaveset(1, waves[(voice + 1) % waves.size()]);
+    setWaveset(2, waves[(voice + 2) % waves.size()]);
+}
+
+float voiceFrequency(const size_t voice)
+{
+    return 55.f * static_cast<float>(voice + 1) + 3.7f * static_cast<float>(voice);
+}
+
+float voiceMorph(const size_t voice)
+{
+    return -1.f + 0.27f * static_cast<float>(voice % 8);
+}
+
+template <size_t Voices>
+void testBankMatchesOscillators()
+{
+    constexpr size_t numSamples{3000};
+    AbacDsp::WaveTableOscillatorBank<Voices> bank{SampleRate};
+    std::vector<std::vector<float>> expected(Voices, std::vector<float>(numSamples));
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        AbacDsp::WaveTableOscillator osc{SampleRate};
+        setupVoice([&](const size_t index, const AbacDsp::BasicWave wave) { osc.setWaveset(index, wave); }, voice);
+        setupVoice([&](const size_t index, const AbacDsp::BasicWave wave) { bank.setWaveset(voice, index, wave); },
+                   voice);
+        osc.setFrequency(voiceFrequency(voice));
+        bank.setFrequency(voice, voiceFrequency(voice));
+        osc.setMorph(voiceMorph(voice));
+        bank.setMorph(voice, voiceMorph(voice));
+        osc.processBlock(expected[voice].data(), numSamples);
+    }
+    std::vector<float> frames(numSamples * Voices);
+    // uneven blocks, the phases continue across calls
+    for (size_t offset = 0; offset < numSamples;)
+    {
+        const auto count = std::min(numSamples - offset, size_t{77});
+        bank.processFrames(frames.data() + offset * Voices, count);
+        offset += count;
+    }
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            // the same phase increments, only the interpolation rounds differently (std::lerp)
+            ASSERT_NEAR(frames[i * Voices + voice], expected[voice][i], 1E-6f) << "voice " << voice << " sample " << i;
+        }
+    }
+}
+
+template <size_t Voices>
+void measureVoicesPerCore()
+{
+    constexpr size_t numSamples{256};
+    constexpr size_t repetitions = static_cast<size_t>(SampleRate) * 4 / numSamples; // 4 seconds of audio
+    std::vector<AbacDsp::WaveTableOscillator> singles(Voices, AbacDsp::WaveTableOscillator(SampleRate));
+    AbacDsp::WaveTableOscillatorBank<Voices> bank{SampleRate};
+    std::array<std::vector<float>, Voices> output;
+    std::array<float*, Voices> out;
+    std::vector<float> frames(numSamples * Voices);
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        setupVoice([&](const size_t index, const AbacDsp::BasicWave wave) { singles[voice].setWaveset(index, wave); },
+                   voice);
+        setupVoice([&](const size_t index, const AbacDsp::BasicWave wave) { bank.setWaveset(voice, index, wave); },
+                   voice);
+        singles[voice].setFrequency(voiceFrequency(voice));
+        bank.setFrequency(voice, voiceFrequency(voice));
+        singles[voice].setMorph(voiceMorph(voice));
+        bank.setMorph(voice, voiceMorph(voice));
+        output[voice].resize(numSamples);
+        out[voice] = output[voice].data();
+    }
+    auto measure = [&](auto&& process) { return Benchmark::voicesPerCore(4., Voices, repetitions, process); };
+    const auto singleVoices = measure(
+        [&]
+        {
+            for (size_t voice = 0; voice < Voices; ++voice)
+            {
+                singles[voice].processBlock(out[voice], numSamples);
+            }
+        });
+    const auto planarVoices = measure([&] { bank.processBlock(out.data(), numSamples); });
+    const auto framesVoices = measure([&] { bank.processFrames(frames.data(), numSamples); });
+    std::cout << Voices << " voices, voices per core: WaveTableOscillator " << singleVoices
+        << ", WaveTableOscillatorBank planar " << planarVoices << ", interleaved " << framesVoices << " ("
+        << output[0][3] + frames[3] << ")\n";
+}
+}
+
+TEST(WaveTableOscillatorBank, matchesSingleOscillators)
+{
+    testBankMatchesOscillators<1>();
+    testBankMatchesOscillators<8>();
+    testBankMatchesOscillators<13>();
+}
+
+TEST(WaveTableOscillatorBank, planarMatchesInterleaved)
+{
+    constexpr size_t Voices{5};
+    constexpr size_t numSamples{200};
+    AbacDsp::WaveTableOscillatorBank<Voices> interleaved{SampleRate};
+    AbacDsp::WaveTableOscillatorBank<Voices> planar{SampleRate};
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        interleaved.setFrequency(voice, voiceFrequency(voice));
+        planar.setFrequency(voice, voiceFrequency(voice));
+        interleaved.setMorph(voice, voiceMorph(voice));
+        planar.setMorph(voice, voiceMorph(voice));
+    }
+    std::vector<float> frames(numSamples * Voices);
+    interleaved.processFrames(frames.data(), numSamples);
+    std::array<std::vector<float>, Voices> output;
+    std::array<float*, Voices> out;
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        output[voice].resize(numSamples);
+        out[voice] = output[voice].data();
+    }
+    planar.processBlock(out.data(), numSamples);
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            ASSERT_EQ(output[voice][i], frames[i * Voices + voice]) << "voice " << voice << " sample " << i;
+        }
+    }
+}
+
+TEST(WaveTableOscillatorBank, noiseIsReproducibleAndPerVoice)
+{
+    constexpr size_t Voices{4};
+    constexpr size_t numSamples{1000};
+    auto render = [&](const uint64_t seed)
+    {
+        AbacDsp::WaveTableOscillatorBank<Voices> bank{SampleRate, seed};
+        // only voice 1 is noise
+        bank.setWaveset(1, 1, AbacDsp::BasicWave::White);
+        bank.setWaveset(1, 2, AbacDsp::BasicWave::White);
+        bank.setMorph(1, 1.f);
+        for (size_t voice = 0; voice < Voices; ++voice)
+        {
+            bank.setFrequency(voice, voiceFrequency(voice));
+        }
+        std::vector<float> frames(numSamples * Voices);
+        bank.processFrames(frames.data(), 100);
+        bank.processFrames(frames.data() + 100 * Voices, numSamples - 100);
+        return frames;
+    };
+    const auto sut = render(1);
+    EXPECT_EQ(sut, render(1));
+    EXPECT_NE(sut, render(2));
+    AbacDsp::WaveTableOscillatorBank<Voices> clean{SampleRate};
+    for (size_t voice = 0; voice < Voices; ++voice)
+    {
+        clean.setFrequency(voice, voiceFrequency(voice));
+    }
+    std::vector<float> expected(numSamples * Voices);
+    clean.processFrames(expected.data(), numSamples);
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        ASSERT_EQ(sut[i * Voices], expected[i * Voices]) << "sample " << i;
+        ASSERT_LE(std::abs(sut[i * Voices + 1]), 2.001f) << "sample " << i;
+    }
+}
+
+TEST(DISABLED_WaveTableOscillatorBank, benchmarkVoicesPerCore)
+{
+    measureVoicesPerCore<8>();
+    measureVoicesPerCore<16>();
+    measureVoicesPerCore<64>();
+    std::cout << std::flush;
+}
@@ -1,12 +1,42 @@
-#include "FftSmall.h"
+#include "Analysis/FftSmall.h"
 
-#include "DSP/Synthesiser/WaveTableOscillator.h"
+#include "Wavetables/WaveTableOscillator.h"
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
 #include <numbers>
 #include <vector>
 
+namespace
+{
+std::atomic<size_t> s_allocations{0};
+}
+
+// counts the allocations of the test binary, see setWavesetDoesNotAllocate. Not inlined, or gcc pairs the malloc()
+// and free() inside with the operator new and delete calls and warns.
+[[gnu::noinline]] void* operator new(const std::size_t size)
+{
+    ++s_allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
 TEST(WaveTableOscillator, pwmAt20Percent)
 {
     constexpr size_t sampleRate{48000};
@@ -41,6 +71,91 @@ TEST(WaveTableOscillator, pwmAt20Percent)
     }
 }
 
+TEST(WaveTableOscillator, noiseIsReproduciblePerStream)
+{
+    constexpr size_t sampleRate{48000};
+    constexpr size_t numSamples{1000};
+    auto render = [&](const uint64_t seed, const uint64_t stream)
+    {
+        AbacDsp::WaveTableOscillator osc{sampleRate, seed, stream};
+        osc.setWaveset(1, AbacDsp::BasicWave::White);
+        osc.setWaveset(2, AbacDsp::BasicWave::White);
+        osc.setMorph(1.f);
+        osc.setFrequency(440.f);
+        std::vector<float> out(numSamples);
+        osc.processBlock(out.data(), 100);
+        osc.processBlock(out.data() + 100, numSamples - 100);
+        return out;
+    };
+    const auto sut = render(1, 0);
+    EXPECT_EQ(sut, render(1, 0));
+    EXPECT_NE(sut, render(1, 1));
+    EXPECT_NE(sut, render(2, 0));
+    for (const auto v : sut)
+    {
+        ASSERT_LE(std::abs(v), 2.001f);
+    }
+}
+
+TEST(WaveTableOscillator, setWavesetDoesNotAllocate)
+{
+    // the tables are shared, a voice is its state
+    static_assert(sizeof(AbacDsp::WaveTableOscillator) < 512);
+    AbacDsp::WaveTableOscillator osc{48000.f};
+    // the sets are built on first use
+    for (size_t wave = 0; wave < static_cast<size_t>(AbacDsp::BasicWave::Last); ++wave)
+    {
+        AbacDsp::WaveTableStore::getTableSet(static_cast<AbacDsp::BasicWave>(wave));
+    }
+    const auto before = s_allocations.load();
+    for (size_t wave = 0; wave < static_cast<size_t>(AbacDsp::BasicWave::Last); ++wave)
+    {
+        osc.setWaveset(wave % 3, static_cast<AbacDsp::BasicWave>(wave));
+        osc.setMorph(static_cast<float>(wave) / 5.f - 1.f);
+    }
+    EXPECT_EQ(s_allocations.load(), before);
+}
+
+TEST(WaveTableOscillator, voicesShareTheTables)
+{
+    AbacDsp::WaveTableOscillator a{48000.f};
+    AbacDsp::WaveTableOscillator b{48000.f};
+    a.setFrequency(440.f);
+    b.setFrequency(440.f);
+    a.setWaveset(2, AbacDsp::BasicWave::Triangle);
+    b.setWaveset(2, AbacDsp::BasicWave::Triangle);
+    a.setMorph(0.3f);
+    b.setMorph(0.3f);
+    std::vector<float> outA(500);
+    std::vector<float> outB(500);
+    a.processBlock(outA.data(), outA.size());
+    b.processBlock(outB.data(), outB.size());
+    EXPECT_EQ(outA, outB);
+}
+
+TEST(WaveTableOscillator, requestWavesetSwapsInThePublishedSet)
+{
+    AbacDsp::WaveTableOscillator requested{48000.f};
+    AbacDsp::WaveTableOscillator expected{48000.f};
+    requested.setFrequency(440.f);
+    expected.setFrequency(440.f);
+    requested.requestWaveset(2, AbacDsp::BasicWave::SharkFin);
+    requested.setMorph(1.f);
+    expected.setMorph(1.f);
+    std::vector<float> out(500);
+    // plays the sine stand in while the set is built
+    while (!AbacDsp::WaveTableStore::tryGetTableSet(AbacDsp::BasicWave::SharkFin).ready)
+    {
+        requested.processBlock(out.data(), out.size());
+        expected.processBlock(out.data(), out.size());
+    }
+    expected.setWaveset(2, AbacDsp::BasicWave::SharkFin);
+    std::vector<float> outExpected(500);
+    requested.processBlock(out.data(), out.size());
+    expected.processBlock(outExpected.data(), outExpected.size());
+    EXPECT_EQ(out, outExpected);
+}
+
 struct OscTestParams
 {
     std::string namedSet;
@@ -247,4 +362,3 @@ INSTANTIATE_TEST_SUITE_P(
                        0.274779f,  -0.260905f, 0.260158f,  -0.263643f, -0.274779f,   0.260905f,  -0.260158f, 0.263643f,
                        0.274779f,  -0.260905f}}),
     WaveTableOscillatorParamTest::PrintToStringParamName());
-}
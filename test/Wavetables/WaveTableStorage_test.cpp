@@ -1,16 +1,171 @@
-#include "FftSmall.h"
+#include "Analysis/FftSmall.h"
 
-#include "DSP/Synthesiser/WaveTableOscillator.h"
+#include "Wavetables/WaveTableAsset.h"
+#include "Wavetables/WaveTableOscillator.h"
+#include "Wavetables/WaveTableOscillatorBank.h"
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <numbers>
+#include <thread>
 #include <vector>
 
+namespace
+{
+void expectMatchesGenerated(const AbacDsp::WaveTableAsset& asset)
+{
+    ASSERT_TRUE(asset.isValid());
+    for (size_t idx = 0; idx < static_cast<size_t>(AbacDsp::BasicWave::Last); ++idx)
+    {
+        const auto wave = static_cast<AbacDsp::BasicWave>(idx);
+        const auto generated = AbacDsp::WaveTableStore::getTableSet(wave).tables;
+        const auto baked = asset.tables(wave);
+        ASSERT_EQ(baked.size(), generated.size()) << "wave " << idx;
+        EXPECT_EQ(std::memcmp(baked.data(), generated.data(), generated.size_bytes()), 0) << "wave " << idx;
+    }
+}
+
+// the background thread publishes the set, the sine stands in until then
+bool fallsBackToSineUntilPublished(const AbacDsp::BasicWave wave)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        const auto [set, ready] = AbacDsp::WaveTableStore::tryGetTableSet(wave);
+        if (ready)
+        {
+            return set.wave == wave && &set == &AbacDsp::WaveTableStore::getTableSet(wave);
+        }
+        // as many tables as the set it stands in for, the table index of any set fits
+        if (set.wave != AbacDsp::BasicWave::Sine || set.tables.size() != 16)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+// the audio thread only leaves a request, the worker builds it once it is started
+bool requestsWaitForTheWorker(const AbacDsp::BasicWave wave)
+{
+    const bool pending = !AbacDsp::WaveTableStore::tryGetTableSet(wave).ready;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const bool stillPending = !AbacDsp::WaveTableStore::tryGetTableSet(wave).ready;
+    AbacDsp::WaveTableStore::startWorker();
+    return pending && stillPending && fallsBackToSineUntilPublished(wave);
+}
+
+// every thread asks for every wave first, half of them blocking, half polling
+bool concurrentFirstAccessSeesOneSet()
+{
+    AbacDsp::WaveTableStore::startWorker();
+    constexpr size_t numThreads{8};
+    constexpr size_t numWaves{static_cast<size_t>(AbacDsp::BasicWave::Last)};
+    std::array<std::array<const AbacDsp::WaveTableSet*, numWaves>, numThreads> seen{};
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back(
+            [&, t]
+            {
+                while (!start.load())
+                {
+                }
+                for (size_t i = 0; i < numWaves; ++i)
+                {
+                    const auto wave = static_cast<AbacDsp::BasicWave>((i + t) % numWaves);
+                    if (t % 2 == 0)
+                    {
+                        seen[t][(i + t) % numWaves] = &AbacDsp::WaveTableStore::getTableSet(wave);
+                        continue;
+                    }
+                    while (!AbacDsp::WaveTableStore::tryGetTableSet(wave).ready)
+                    {
+                        std::this_thread::yield();
+                    }
+                    seen[t][(i + t) % numWaves] = &AbacDsp::WaveTableStore::tryGetTableSet(wave).set;
+                }
+            });
+    }
+    start = true;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (size_t i = 0; i < numWaves; ++i)
+    {
+        const auto& set = AbacDsp::WaveTableStore::getTableSet(static_cast<AbacDsp::BasicWave>(i));
+        if (set.wave != static_cast<AbacDsp::BasicWave>(i) || set.tables.empty())
+        {
+            return false;
+        }
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            if (seen[t][i] != &set)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// the peak of a block, the sine stand-in plays at the level of the compensated sine set
+bool playsTheStandIn(const std::vector<float>& out, const AbacDsp::BasicWave pending)
+{
+    const float peak = std::abs(*std::ranges::max_element(out, {}, [](const float v) { return std::abs(v); }));
+    // published meanwhile, then the block may have played either
+    return AbacDsp::WaveTableStore::tryGetTableSet(pending).ready || (peak > 0.6f && peak < 0.71f);
+}
+
+// morphs from a high table of a published set onto the stand-in of a set that is still built
+bool morphOntoPendingSetPlaysTheStandIn()
+{
+    constexpr size_t numSamples{256};
+    std::vector<float> out(numSamples);
+    AbacDsp::WaveTableOscillator osc{48000.f};
+    osc.setFrequency(6000.f);
+    osc.setMorph(-1.f);
+    osc.requestWaveset(2, AbacDsp::BasicWave::Pulse);
+    osc.setMorph(1.f);
+    // sample by sample, nothing picks the tables again
+    std::ranges::generate(out, [&] { return osc.process(); });
+
+    constexpr size_t Voices{4};
+    AbacDsp::WaveTableOscillatorBank<Voices> bank{48000.f};
+    std::vector<float> frames(numSamples * Voices);
+    bank.setFrequency(1, 6000.f);
+    bank.setMorph(1, -1.f);
+    bank.requestWaveset(1, 2, AbacDsp::BasicWave::Pulse1);
+    bank.setMorph(1, 1.f);
+    bank.processFrames(frames.data(), numSamples);
+    std::vector<float> voice(numSamples);
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        voice[i] = frames[i * Voices + 1];
+    }
+    return playsTheStandIn(out, AbacDsp::BasicWave::Pulse) && playsTheStandIn(voice, AbacDsp::BasicWave::Pulse1);
+}
+
+void writeBytes(const std::filesystem::path& path, const std::vector<char>& bytes)
+{
+    std::ofstream(path, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+}
+
 
 TEST(WaveTableStorageTest, wavetableStorageSingle)
 {
-    AbacDsp::WaveTableSet& wtbl = AbacDsp::WaveTableStore::getTableSet(AbacDsp::BasicWave::Saw);
+    const AbacDsp::WaveTableSet& wtbl = AbacDsp::WaveTableStore::getTableSet(AbacDsp::BasicWave::Saw);
     EXPECT_EQ(wtbl.tables.size(), 16);
     EXPECT_EQ(wtbl.getIndexByFrequency(0.0001f), 0);
     EXPECT_EQ(wtbl.getIndexByFrequency(0.001f), 2);
@@ -30,7 +185,7 @@ TEST(WaveTableStorageTest, checkLevels)
     };
     for (size_t idx = 0; idx < static_cast<size_t>(AbacDsp::BasicWave::Last); ++idx)
     {
-        AbacDsp::WaveTableSet& vwtbl = AbacDsp::WaveTableStore::getTableSet(static_cast<AbacDsp::BasicWave>(idx));
+        const AbacDsp::WaveTableSet& vwtbl = AbacDsp::WaveTableStore::getTableSet(static_cast<AbacDsp::BasicWave>(idx));
 
         float absMax = 0;
         for (size_t j = 0; j < vwtbl.tables.size(); ++j)
@@ -43,3 +198,90 @@ TEST(WaveTableStorageTest, checkLevels)
         EXPECT_NEAR(expected[idx], absMax, 1E-4f);
     }
 }
+
+TEST(WaveTableStorageTest, bakedAssetMatchesGeneratedTables)
+{
+    // the asset of the build target, baked by another binary
+    expectMatchesGenerated(AbacDsp::WaveTableAsset{WAVETABLE_ASSET});
+    const auto path = std::filesystem::temp_directory_path() / "WaveTableStorageTest.bin";
+    ASSERT_TRUE(AbacDsp::WaveTableStore::writeAsset(path.string()));
+    expectMatchesGenerated(AbacDsp::WaveTableAsset{path.string()});
+    std::filesystem::remove(path);
+}
+
+TEST(WaveTableStorageTest, rejectsForeignAssets)
+{
+    EXPECT_FALSE(AbacDsp::WaveTableAsset{"does/not/exist.bin"}.isValid());
+    const auto path = std::filesystem::temp_directory_path() / "WaveTableStorageTestForeign.bin";
+    ASSERT_TRUE(AbacDsp::WaveTableStore::writeAsset(path.string()));
+    std::vector<char> bytes(std::filesystem::file_size(path));
+    std::ifstream(path, std::ios::binary).read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+    auto truncated = bytes;
+    truncated.resize(bytes.size() - 4);
+    writeBytes(path, truncated);
+    EXPECT_FALSE(AbacDsp::WaveTableAsset{path.string()}.isValid());
+
+    auto otherVersion = bytes;
+    otherVersion[offsetof(AbacDsp::WaveTableAssetHeader, version)] += 1;
+    writeBytes(path, otherVersion);
+    EXPECT_FALSE(AbacDsp::WaveTableAsset{path.string()}.isValid());
+
+    writeBytes(path, bytes);
+    EXPECT_TRUE(AbacDsp::WaveTableAsset{path.string()}.isValid());
+    std::filesystem::remove(path);
+}
+
+TEST(WaveTableStorageTest, useAssetMapsTheTables)
+{
+    // in a fresh child process, the tables of this one are already built
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_EXIT(
+        {
+            // a set built before stays
+            const auto* sine = AbacDsp::WaveTableStore::getTableSet(AbacDsp::BasicWave::Sine).tables.data();
+            const bool mapped = AbacDsp::WaveTableStore::useAsset(WAVETABLE_ASSET);
+            const bool once = !AbacDsp::WaveTableStore::useAsset(WAVETABLE_ASSET);
+            const AbacDsp::WaveTableAsset asset{WAVETABLE_ASSET};
+            const auto& saw = AbacDsp::WaveTableStore::getTableSet(AbacDsp::BasicWave::Saw);
+            const bool same = saw.tables.size() == asset.tables(AbacDsp::BasicWave::Saw).size() &&
+                std::memcmp(saw.tables.data(), asset.tables(AbacDsp::BasicWave::Saw).data(),
+                            saw.tables.size_bytes()) == 0;
+            const bool kept = AbacDsp::WaveTableStore::getTableSet(AbacDsp::BasicWave::Sine).tables.data() == sine;
+            std::exit(mapped && once && same && kept ? 0 : 1);
+        },
+        testing::ExitedWithCode(0), "");
+}
+
+TEST(WaveTableStorageTest, useAssetFallsBackToGenerating)
+{
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_EXIT(
+        {
+            const bool mapped = AbacDsp::WaveTableStore::useAsset("does/not/exist.bin");
+            const auto& saw = AbacDsp::WaveTableStore::getTableSet(AbacDsp::BasicWave::Saw);
+            std::exit(!mapped && saw.tables.size() == 16 ? 0 : 1);
+        },
+        testing::ExitedWithCode(0), "");
+}
+
+TEST(WaveTableStorageTest, tryGetTableSetFallsBackToSine)
+{
+    // in a fresh child process, where no set is built yet
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_EXIT(std::exit(requestsWaitForTheWorker(AbacDsp::BasicWave::Saw) ? 0 : 1), testing::ExitedWithCode(0), "");
+    AbacDsp::WaveTableStore::startWorker();
+    EXPECT_TRUE(fallsBackToSineUntilPublished(AbacDsp::BasicWave::Triangle));
+}
+
+TEST(WaveTableStorageTest, morphOntoPendingSet)
+{
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_EXIT(std::exit(morphOntoPendingSetPlaysTheStandIn() ? 0 : 1), testing::ExitedWithCode(0), "");
+}
+
+TEST(WaveTableStorageTest, concurrentFirstAccess)
+{
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_EXIT(std::exit(concurrentFirstAccessSeesOneSet() ? 0 : 1), testing::ExitedWithCode(0), "");
+}
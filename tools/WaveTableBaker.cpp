@@ -0,0 +1,15 @@
+#include <iostream>
+
+#include "Wavetables/WaveTableStorage.h"
+
+// bakes the band limited tables of all BasicWaves into the asset WaveTableStore::useAsset() maps
+int main(const int argc, const char* argv[])
+{
+    const std::string path = argc > 1 ? argv[1] : "wavetables.bin";
+    if (!AbacDsp::WaveTableStore::writeAsset(path))
+    {
+        std::cerr << "could not write " << path << "\n";
+        return 1;
+    }
+    return 0;
+}